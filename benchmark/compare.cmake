@@ -0,0 +1,72 @@
+# -------------------------------------------------------------------------- #
+# cppreg benchmark comparison script
+#
+# Nicolas Clauvelin (nclauvelin@sendyne.com)
+# Sendyne Corp., 2022
+#
+# Usage: cmake -DLABEL=<label> -DOPERATIONS=<op;op;...>
+#              -DCPPREG_ASM=<file> -DCMSIS_ASM=<file>
+#              -DCPPREG_OBJ=<file> -DCMSIS_OBJ=<file> -DNM=<nm>
+#              -P compare.cmake
+#
+# For each operation this reports the instruction count (from the assembly
+# output) and the code size (from the symbol table) of the cppreg and CMSIS
+# implementations, and fails if the cppreg implementation is larger.
+# -------------------------------------------------------------------------- #
+
+
+# Instruction count of a function from an assembly file.
+function(count_instructions asm_file function_name result)
+    file(STRINGS ${asm_file} lines)
+    set(inside FALSE)
+    set(count 0)
+    foreach(line IN LISTS lines)
+        if(line MATCHES "^_?${function_name}:")
+            set(inside TRUE)
+        elseif(inside AND line MATCHES "^[ \t]*\\.size[ \t]")
+            break()
+        elseif(inside AND line MATCHES "^[ \t]+[a-z]")
+            math(EXPR count "${count} + 1")
+        endif()
+    endforeach()
+    set(${result} ${count} PARENT_SCOPE)
+endfunction()
+
+
+# Code size of a function from an object file.
+function(code_size obj_file function_name result)
+    execute_process(COMMAND ${NM} -S ${obj_file}
+                    OUTPUT_VARIABLE symbols)
+    set(size 0)
+    if(symbols MATCHES "[0-9a-fA-F]+ ([0-9a-fA-F]+) [tT] _?${function_name}\n")
+        math(EXPR size "0x${CMAKE_MATCH_1}")
+        # Thumb functions have their lowest address bit set (not the size).
+    endif()
+    set(${result} ${size} PARENT_SCOPE)
+endfunction()
+
+
+set(status 0)
+message(STATUS "cppreg benchmark: ${LABEL}")
+message(STATUS "  operation          insn (cppreg/cmsis)  bytes (cppreg/cmsis)")
+foreach(op IN LISTS OPERATIONS)
+    count_instructions(${CPPREG_ASM} cppreg_${op} cppreg_insn)
+    count_instructions(${CMSIS_ASM} cmsis_${op} cmsis_insn)
+    code_size(${CPPREG_OBJ} cppreg_${op} cppreg_size)
+    code_size(${CMSIS_OBJ} cmsis_${op} cmsis_size)
+    set(result "ok")
+    if(cppreg_insn GREATER cmsis_insn OR cppreg_size GREATER cmsis_size)
+        set(result "OVERHEAD")
+        set(status 1)
+    endif()
+    string(SUBSTRING "${op}                  " 0 18 name)
+    string(SUBSTRING "${cppreg_insn}/${cmsis_insn}                     "
+           0 21 insn)
+    string(SUBSTRING "${cppreg_size}/${cmsis_size}                     "
+           0 21 size)
+    message(STATUS "  ${name} ${insn}${size}${result}")
+endforeach()
+
+if(status)
+    message(FATAL_ERROR "cppreg benchmark: overhead detected for ${LABEL}")
+endif()
@@ -0,0 +1,50 @@
+//! cppreg benchmark corpus declarations.
+/**
+ * @file      corpus.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ */
+
+
+#ifndef CPPREG_BENCHMARK_CORPUS_H
+#define CPPREG_BENCHMARK_CORPUS_H
+
+
+#include "cppreg.h"
+
+
+//! Memory access counter (tracer used for host builds).
+struct access_counter {    // NOLINT
+
+    //! Number of reads and writes.
+    static std::size_t reads;     // NOLINT
+    static std::size_t writes;    // NOLINT
+
+    //! Record method.
+    static void record(cppreg::Address,
+                       cppreg::RegBitSize,
+                       std::uint64_t,
+                       const cppreg::TraceAccess access) noexcept {
+        if (access == cppreg::TraceAccess::read) {
+            ++reads;
+        } else {
+            ++writes;
+        }
+    }
+};
+
+
+//!@{ Benchmark corpus (see corpus_cppreg.cpp and corpus_cmsis.c).
+extern "C" {
+std::uint32_t cppreg_field_read();
+void cppreg_field_write(std::uint32_t value);
+void cppreg_constant_write();
+void cppreg_merge_write();
+void cppreg_shadow_write(std::uint8_t value);
+void cppreg_pack_loop();
+void cppreg_toggle();
+}
+//!@}
+
+
+#endif    // CPPREG_BENCHMARK_CORPUS_H
@@ -0,0 +1,86 @@
+/*
+ * cppreg benchmark corpus (CMSIS-style C reference).
+ *
+ * Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * Sendyne Corp., 2022
+ *
+ * Each function has an equivalent in corpus_cppreg.cpp (same name with the
+ * cppreg_ prefix instead of cmsis_).
+ */
+
+
+#include <stdint.h>
+
+
+/* Peripheral definitions. */
+#define __IO volatile
+#define __I volatile const
+typedef struct {
+    __IO uint32_t CTRL;    /* Base + 0x00 */
+    __I uint32_t STATUS;   /* Base + 0x04 */
+    __IO uint32_t CNT;     /* Base + 0x08 */
+    __IO uint32_t CCR[4];  /* Base + 0x0C */
+} TIMER_TypeDef;
+typedef struct {
+    __IO uint8_t DIRECTION; /* Base + 0x00 */
+    __IO uint8_t TOGGLE;    /* Base + 0x01 */
+    __IO uint8_t OUT;       /* Base + 0x02 (write-only) */
+} GPIO_TypeDef;
+
+#define TIMER_BASE ((uint32_t)0x40010000)
+#define TIMER ((TIMER_TypeDef*)TIMER_BASE)
+#define GPIO_BASE ((uint32_t)0x40020000)
+#define GPIO ((GPIO_TypeDef*)GPIO_BASE)
+
+#define TIMER_CTRL_EN_Msk (0x1u << 0)
+#define TIMER_CTRL_MODE_Pos 1u
+#define TIMER_CTRL_MODE_Msk (0x7u << TIMER_CTRL_MODE_Pos)
+#define TIMER_CTRL_PRESC_Pos 8u
+#define TIMER_CTRL_PRESC_Msk (0xFFu << TIMER_CTRL_PRESC_Pos)
+#define GPIO_DIRECTION_PIN3_Msk (0x1u << 3)
+#define GPIO_OUT_PIN2_Pos 2u
+#define GPIO_OUT_PIN2_Msk (0x3u << GPIO_OUT_PIN2_Pos)
+
+/* Shadow value for the write-only output register. */
+static uint8_t gpio_out_shadow = 0u;
+
+
+uint32_t cmsis_field_read(void) {
+    return (TIMER->CTRL & TIMER_CTRL_PRESC_Msk) >> TIMER_CTRL_PRESC_Pos;
+}
+
+void cmsis_field_write(uint32_t value) {
+    TIMER->CTRL = (TIMER->CTRL & ~TIMER_CTRL_PRESC_Msk)
+                  | ((value << TIMER_CTRL_PRESC_Pos) & TIMER_CTRL_PRESC_Msk);
+}
+
+void cmsis_constant_write(void) {
+    TIMER->CTRL = (TIMER->CTRL & ~TIMER_CTRL_MODE_Msk)
+                  | (0x5u << TIMER_CTRL_MODE_Pos);
+}
+
+void cmsis_merge_write(void) {
+    TIMER->CTRL = (TIMER->CTRL
+                   & ~(TIMER_CTRL_EN_Msk | TIMER_CTRL_MODE_Msk
+                       | TIMER_CTRL_PRESC_Msk))
+                  | TIMER_CTRL_EN_Msk | (0x2u << TIMER_CTRL_MODE_Pos)
+                  | (0x10u << TIMER_CTRL_PRESC_Pos);
+}
+
+void cmsis_shadow_write(uint8_t value) {
+    gpio_out_shadow = (uint8_t)((gpio_out_shadow & ~GPIO_OUT_PIN2_Msk)
+                                | ((value << GPIO_OUT_PIN2_Pos)
+                                   & GPIO_OUT_PIN2_Msk));
+    GPIO->OUT = gpio_out_shadow;
+}
+
+void cmsis_pack_loop(void) {
+    TIMER->CCR[0] = 0u;
+    TIMER->CCR[1] = 1u;
+    TIMER->CCR[2] = 2u;
+    TIMER->CCR[3] = 3u;
+}
+
+void cmsis_toggle(void) {
+    GPIO->DIRECTION ^= GPIO_DIRECTION_PIN3_Msk;
+}
@@ -0,0 +1,105 @@
+//! cppreg benchmark corpus.
+/**
+ * @file      corpus_cppreg.cpp
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * Each function has an equivalent in corpus_cmsis.c (same name with the
+ * cmsis_ prefix instead of cppreg_). If CPPREG_BENCHMARK_HOST is defined
+ * the packs use the simulated memory backend with an access counter (to
+ * count the memory accesses on a host).
+ */
+
+
+#include "corpus.h"
+
+
+namespace {
+
+#if defined(CPPREG_BENCHMARK_HOST)
+using backend =    // NOLINT
+    cppreg::traced_memory<cppreg::simulated_memory<>, access_counter>;
+#else
+using backend = cppreg::physical_memory;    // NOLINT
+#endif
+
+// Peripheral definitions.
+struct TIMER {
+    struct Pack : cppreg::RegisterPack<0x40010000, 28, backend> {};
+    struct CTRL : cppreg::PackedRegister<Pack, cppreg::RegBitSize::b32, 0> {
+        using EN = cppreg::Field<CTRL, 1u, 0u, cppreg::read_write>;
+        using MODE = cppreg::Field<CTRL, 3u, 1u, cppreg::read_write>;
+        using PRESC = cppreg::Field<CTRL, 8u, 8u, cppreg::read_write>;
+    };
+    template <std::uint32_t n>
+    struct CCR
+        : cppreg::
+              PackedRegister<Pack, cppreg::RegBitSize::b32, 96 + (n * 32)> {
+        using VALUE = cppreg::Field<CCR, 32u, 0u, cppreg::read_write>;
+    };
+    using channels =
+        cppreg::PackIndexing<CCR<0>::VALUE,
+                             CCR<1>::VALUE,
+                             CCR<2>::VALUE,
+                             CCR<3>::VALUE>;
+};
+struct GPIO {
+    struct Pack : cppreg::RegisterPack<0x40020000, 4, backend> {};
+    struct DIRECTION
+        : cppreg::PackedRegister<Pack, cppreg::RegBitSize::b8, 0> {
+        using PIN3 = cppreg::Field<DIRECTION, 1u, 3u, cppreg::read_write>;
+    };
+    struct OUT : cppreg::PackedRegister<Pack,
+                                        cppreg::RegBitSize::b8,
+                                        16,
+                                        0x0,
+                                        true> {
+        using PIN2 = cppreg::Field<OUT, 2u, 2u, cppreg::write_only>;
+    };
+};
+
+// Loop body for the pack loop.
+struct write_channel {    // NOLINT
+    template <std::size_t index>
+    void operator()() const noexcept {
+        TIMER::channels::elem<index>::template write<index>();
+    }
+};
+
+}    // namespace
+
+
+extern "C" {
+
+std::uint32_t cppreg_field_read() {
+    return TIMER::CTRL::PRESC::read();
+}
+
+void cppreg_field_write(const std::uint32_t value) {
+    TIMER::CTRL::PRESC::write(value);
+}
+
+void cppreg_constant_write() {
+    TIMER::CTRL::MODE::write<0x5>();
+}
+
+void cppreg_merge_write() {
+    TIMER::CTRL::merge_write<TIMER::CTRL::EN, 0x1>()
+        .with<TIMER::CTRL::MODE, 0x2>()
+        .with<TIMER::CTRL::PRESC, 0x10>()
+        .done();
+}
+
+void cppreg_shadow_write(const std::uint8_t value) {
+    GPIO::OUT::PIN2::write(value);
+}
+
+void cppreg_pack_loop() {
+    cppreg::pack_loop<TIMER::channels>::apply<write_channel>();
+}
+
+void cppreg_toggle() {
+    GPIO::DIRECTION::PIN3::toggle();
+}
+
+}    // extern "C"
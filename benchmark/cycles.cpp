@@ -0,0 +1,336 @@
+//! cppreg benchmark cycle counts.
+/**
+ * @file      cycles.cpp
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This times the cppreg primitives and prints a CSV report (one line per
+ * backend and operation) with the number of ticks per operation. Each
+ * operation is called CPPREG_BENCHMARK_ITERATIONS times and the cost of the
+ * call itself (measured with an empty operation) is subtracted.
+ *
+ * The ticks are:
+ * - on Cortex-M cores, the DWT cycle counter if available (ARMv7-M and
+ *   ARMv8-M mainline), otherwise the SysTick counter (e.g., ARMv6-M cores or
+ *   QEMU, which does not implement the DWT cycle counter),
+ * - on a host, nanoseconds from the steady clock.
+ *
+ * The operations are run with the simulated memory backend and, if
+ * CPPREG_BENCHMARK_PHYSICAL_BASE is defined (address of a region of at least
+ * 24 bytes of RAM or of read-write registers), with the physical memory
+ * backend. The bit-band operation is only included if
+ * CPPREG_BENCHMARK_BIT_BAND is defined (the physical base address has then
+ * to be in a bit-band region of a Cortex-M3/M4 core).
+ */
+
+
+#include "cppreg.h"
+
+#include <cstdio>
+#if !defined(__arm__)
+#include <chrono>
+#endif
+
+
+#if !defined(CPPREG_BENCHMARK_ITERATIONS)
+#define CPPREG_BENCHMARK_ITERATIONS 1000U
+#endif
+
+// The atomic policy requires exclusive access instructions on ARM targets.
+#if !defined(__arm__) || defined(__ARM_FEATURE_LDREX)
+#define CPPREG_BENCHMARK_ATOMIC
+#endif
+
+
+namespace {
+
+//! Number of calls per operation.
+constexpr std::uint32_t iterations = CPPREG_BENCHMARK_ITERATIONS;
+
+//!@{ Operations input and output.
+volatile std::uint32_t input = 0x42U;    // NOLINT
+volatile std::uint32_t sink = 0U;        // NOLINT
+//!@}
+
+
+#if defined(__arm__)
+
+//!@{ Cortex-M debug and SysTick registers.
+struct DEMCR : cppreg::Register<0xE000EDFC, cppreg::RegBitSize::b32> {
+    using TRCENA = cppreg::Field<DEMCR, 1u, 24u, cppreg::read_write>;
+};
+struct DWT_CTRL : cppreg::Register<0xE0001000, cppreg::RegBitSize::b32> {
+    using CYCCNTENA = cppreg::Field<DWT_CTRL, 1u, 0u, cppreg::read_write>;
+};
+struct DWT_CYCCNT : cppreg::Register<0xE0001004, cppreg::RegBitSize::b32> {
+    using CYCCNT = cppreg::Field<DWT_CYCCNT, 32u, 0u, cppreg::read_write>;
+};
+struct SYST_CSR : cppreg::Register<0xE000E010, cppreg::RegBitSize::b32> {
+    using ENABLE = cppreg::Field<SYST_CSR, 1u, 0u, cppreg::read_write>;
+    using CLKSOURCE = cppreg::Field<SYST_CSR, 1u, 2u, cppreg::read_write>;
+};
+struct SYST_RVR : cppreg::Register<0xE000E014, cppreg::RegBitSize::b32> {
+    using RELOAD = cppreg::Field<SYST_RVR, 24u, 0u, cppreg::read_write>;
+};
+struct SYST_CVR : cppreg::Register<0xE000E018, cppreg::RegBitSize::b32> {
+    using CURRENT = cppreg::Field<SYST_CVR, 24u, 0u, cppreg::read_write>;
+};
+//!@}
+
+#endif    // __arm__
+
+
+//! Tick counter.
+struct tick_counter {    // NOLINT
+
+    //! Counter name and unit.
+    static const char* source;    // NOLINT
+    static const char* unit;      // NOLINT
+
+    //! Counter mask (for wrapping around).
+    static std::uint32_t mask;    // NOLINT
+
+#if defined(__arm__)
+    //! Use the SysTick counter (instead of the DWT cycle counter).
+    static bool use_systick;    // NOLINT
+#endif
+
+    //! Counter initialization.
+    static void init() noexcept {
+#if defined(__arm__)
+#if !defined(__ARM_ARCH_6M__)
+        DEMCR::TRCENA::set();
+        DWT_CYCCNT::CYCCNT::write<0x0>();
+        DWT_CTRL::CYCCNTENA::set();
+        const auto start = cppreg::dwt_cycle_counter::now();
+        __asm__ volatile("nop\n\tnop\n\tnop\n\tnop");
+        if (cppreg::dwt_cycle_counter::now() != start) {
+            source = "dwt";
+            return;
+        }
+#endif
+        // The cycle counter is not implemented: use the SysTick counter
+        // with the processor clock.
+        SYST_RVR::RELOAD::write<0xFFFFFF>();
+        SYST_CVR::CURRENT::write<0x0>();
+        SYST_CSR::merge_write<SYST_CSR::CLKSOURCE, 0x1>()
+            .with<SYST_CSR::ENABLE, 0x1>()
+            .done();
+        use_systick = true;
+        source = "systick";
+        mask = 0xFFFFFFU;
+#endif
+    }
+
+    //! Current tick value.
+    static std::uint32_t now() noexcept {
+#if defined(__arm__)
+        // The SysTick counter is counting down.
+        return use_systick ? static_cast<std::uint32_t>(
+                   0xFFFFFFU - SYST_CVR::CURRENT::read())
+                           : cppreg::dwt_cycle_counter::now();
+#else
+        return static_cast<std::uint32_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+#endif
+    }
+};
+
+#if defined(__arm__)
+const char* tick_counter::source = "dwt";
+const char* tick_counter::unit = "cycles";
+bool tick_counter::use_systick = false;
+#else
+const char* tick_counter::source = "steady_clock";
+const char* tick_counter::unit = "ns";
+#endif
+std::uint32_t tick_counter::mask = 0xFFFFFFFFU;
+
+
+//! Peripheral definitions.
+/**
+ * @tparam Backend Memory backend type.
+ * @tparam base Peripheral base address.
+ */
+template <typename Backend, cppreg::Address base>
+struct Peripheral {
+    struct Pack : cppreg::RegisterPack<base, 24, Backend> {};
+    struct CTRL : cppreg::PackedRegister<Pack, cppreg::RegBitSize::b32, 0> {
+        using EN = cppreg::Field<CTRL, 1u, 0u, cppreg::read_write>;
+        using MODE = cppreg::Field<CTRL, 3u, 1u, cppreg::read_write>;
+        using PRESC = cppreg::Field<CTRL, 8u, 8u, cppreg::read_write>;
+        using BB = cppreg::Field<CTRL, 1u, 16u, cppreg::bit_band_read_write>;
+        using AT = cppreg::Field<CTRL, 1u, 17u, cppreg::atomic_read_write>;
+    };
+    struct OUT : cppreg::PackedRegister<Pack,
+                                        cppreg::RegBitSize::b8,
+                                        32,
+                                        0x0,
+                                        true> {
+        using PIN2 = cppreg::Field<OUT, 2u, 2u, cppreg::write_only>;
+    };
+    template <std::uint32_t n>
+    struct CCR
+        : cppreg::
+              PackedRegister<Pack, cppreg::RegBitSize::b32, 64 + (n * 32)> {
+        using VALUE = cppreg::Field<CCR, 32u, 0u, cppreg::read_write>;
+    };
+    using channels =
+        cppreg::PackIndexing<typename CCR<0>::VALUE,
+                             typename CCR<1>::VALUE,
+                             typename CCR<2>::VALUE,
+                             typename CCR<3>::VALUE>;
+};
+
+
+//! Benchmark entry.
+struct Entry {    // NOLINT
+    const char* name;
+    void (*op)();
+};
+
+
+//! Benchmark operations.
+/**
+ * @tparam P Peripheral type.
+ */
+template <typename P>
+struct Operations {    // NOLINT
+
+    using CTRL = typename P::CTRL;    // NOLINT
+    using OUT = typename P::OUT;      // NOLINT
+
+    //! Loop body for the pack loop.
+    struct write_channel {    // NOLINT
+        template <std::size_t index>
+        void operator()() const noexcept {
+            P::channels::template elem<index>::template write<index>();
+        }
+    };
+
+    __attribute__((noinline)) static void empty() {
+        __asm__ volatile("" ::: "memory");
+    }
+    __attribute__((noinline)) static void field_read() {
+        sink = CTRL::PRESC::read();
+    }
+    __attribute__((noinline)) static void field_write() {
+        CTRL::PRESC::write(input);
+    }
+    __attribute__((noinline)) static void constant_write() {
+        CTRL::MODE::template write<0x5>();
+    }
+    __attribute__((noinline)) static void set() {
+        CTRL::EN::set();
+    }
+    __attribute__((noinline)) static void clear() {
+        CTRL::EN::clear();
+    }
+    __attribute__((noinline)) static void toggle() {
+        CTRL::EN::toggle();
+    }
+    __attribute__((noinline)) static void merge_write() {
+        CTRL::template merge_write<typename CTRL::EN>(input & 0x1U)
+            .template with<typename CTRL::MODE>(input)
+            .template with<typename CTRL::PRESC>(input)
+            .done();
+    }
+    __attribute__((noinline)) static void merge_write_constant() {
+        CTRL::template merge_write<typename CTRL::EN, 0x1>()
+            .template with<typename CTRL::MODE, 0x2>()
+            .template with<typename CTRL::PRESC, 0x10>()
+            .done();
+    }
+    __attribute__((noinline)) static void shadow_write() {
+        OUT::PIN2::write(static_cast<std::uint8_t>(input));
+    }
+    __attribute__((noinline)) static void pack_loop() {
+        cppreg::pack_loop<typename P::channels>::template apply<
+            write_channel>();
+    }
+    __attribute__((noinline)) static void bit_band_set() {
+        CTRL::BB::set();
+    }
+    __attribute__((noinline)) static void atomic_set() {
+        CTRL::AT::set();
+    }
+
+    //! Time an operation.
+    /**
+     * @param op Operation.
+     * @return Ticks for all the iterations.
+     */
+    __attribute__((noinline)) static std::uint32_t measure(void (*op)()) {
+        const auto start = tick_counter::now();
+        for (std::uint32_t i = 0U; i < iterations; ++i) {
+            op();
+        }
+        return (tick_counter::now() - start) & tick_counter::mask;
+    }
+
+    //! Run and report all the operations.
+    /**
+     * @param backend Backend name.
+     */
+    static void run(const char* backend) {
+        const Entry entries[] = {
+            {"field_read", field_read},
+            {"field_write", field_write},
+            {"constant_write", constant_write},
+            {"set", set},
+            {"clear", clear},
+            {"toggle", toggle},
+            {"merge_write", merge_write},
+            {"merge_write_constant", merge_write_constant},
+            {"shadow_write", shadow_write},
+            {"pack_loop", pack_loop},
+#if defined(CPPREG_BENCHMARK_BIT_BAND)
+            {"bit_band_set", bit_band_set},
+#endif
+#if defined(CPPREG_BENCHMARK_ATOMIC)
+            {"atomic_set", atomic_set},
+#endif
+        };
+
+        // Cost of the call (and loop) only; the first run is a warm-up.
+        static_cast<void>(measure(empty));
+        const std::uint32_t overhead = measure(empty);
+
+        for (const auto& entry : entries) {
+            const std::uint32_t total = measure(entry.op);
+            const std::uint32_t net = (total > overhead) ? total - overhead
+                                                         : 0U;
+            const std::uint64_t hundredths =
+                (static_cast<std::uint64_t>(net) * 100U) / iterations;
+            std::printf("%s,%s,%lu,%lu.%02lu\n",
+                        backend,
+                        entry.name,
+                        static_cast<unsigned long>(iterations),
+                        static_cast<unsigned long>(hundredths / 100U),
+                        static_cast<unsigned long>(hundredths % 100U));
+        }
+    }
+};
+
+}    // namespace
+
+
+int main() {
+    tick_counter::init();
+
+    std::printf("# cppreg cycles counter=%s unit=%s\n",
+                tick_counter::source,
+                tick_counter::unit);
+    std::printf("backend,operation,iterations,per_op\n");
+
+    Operations<Peripheral<cppreg::simulated_memory<>, 0x40010000>>::run(
+        "simulated");
+#if defined(CPPREG_BENCHMARK_PHYSICAL_BASE)
+    Operations<Peripheral<cppreg::physical_memory,
+                          CPPREG_BENCHMARK_PHYSICAL_BASE>>::run("physical");
+#endif
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+//! cppreg benchmark memory access counts.
+/**
+ * @file      mmio_count.cpp
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This runs the benchmark corpus on a host (simulated memory backend) and
+ * reports the number of memory reads and writes of each operation. The
+ * counts are compared with the minimal number of accesses (i.e., the ones
+ * of the CMSIS-style implementation).
+ */
+
+
+#include "corpus.h"
+
+#include <cstdio>
+
+
+std::size_t access_counter::reads = 0U;
+std::size_t access_counter::writes = 0U;
+
+
+namespace {
+
+//!@{ Wrappers for operations with arguments.
+void field_read() {
+    static_cast<void>(cppreg_field_read());
+}
+void field_write() {
+    cppreg_field_write(0x42U);
+}
+void shadow_write() {
+    cppreg_shadow_write(0x2U);
+}
+//!@}
+
+//! Benchmark entry.
+struct Entry {    // NOLINT
+    const char* name;
+    void (*op)();
+    std::size_t reads;
+    std::size_t writes;
+};
+
+}    // namespace
+
+
+int main() {
+    const Entry entries[] = {{"field_read", field_read, 1U, 0U},
+                             {"field_write", field_write, 1U, 1U},
+                             {"constant_write", cppreg_constant_write, 1U, 1U},
+                             {"merge_write", cppreg_merge_write, 1U, 1U},
+                             {"shadow_write", shadow_write, 0U, 1U},
+                             {"pack_loop", cppreg_pack_loop, 0U, 4U},
+                             {"toggle", cppreg_toggle, 1U, 1U}};
+
+    int status = 0;
+    std::printf("%-16s %8s %8s %8s\n", "operation", "reads", "writes", "");
+    for (const auto& entry : entries) {
+        access_counter::reads = 0U;
+        access_counter::writes = 0U;
+        entry.op();
+        const bool ok = (access_counter::reads == entry.reads)
+                        && (access_counter::writes == entry.writes);
+        std::printf("%-16s %8zu %8zu %8s\n",
+                    entry.name,
+                    access_counter::reads,
+                    access_counter::writes,
+                    ok ? "ok" : "MISMATCH");
+        status |= ok ? 0 : 1;
+    }
+    return status;
+}
@@ -10,11 +10,21 @@
 #define CPPREG_CPPREG_H
 
 
+#include "Barrier.h"
+#include "BusRegister.h"
+#include "DeferredWrite.h"
+#include "FifoRegister.h"
 #include "Field.h"
 #include "Internals.h"
 #include "MergeWrite.h"
+#include "PackImage.h"
+#include "PackSnapshot.h"
+#include "PackState.h"
 #include "Register.h"
+#include "RegisterArray.h"
 #include "RegisterPack.h"
+#include "RegisterValue.h"
+#include "SharedShadow.h"
 
 
 #endif    // CPPREG_CPPREG_H
@@ -13,6 +13,7 @@
 #include <cstdint>
 #include <limits>
 #include <tuple>
+#include <utility>
 
 
 #endif    // CPPREG_CPPREG_INCLUDES_H
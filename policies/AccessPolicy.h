@@ -5,7 +5,11 @@
  * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
  *
  * Access policies are used to describe if register fields are read-write,
- * read-only or write-only.
+ * read-only or write-only. Additional policies describe fields with special
+ * hardware behavior (write-1-to-clear, write-1-to-set, read-to-clear) and
+ * fields with set/clear/toggle alias registers, and single bit fields
+ * accessed through bit-band alias words. The atomic policy performs the
+ * read-modify-write operations using lock-free atomic updates.
  *
  * - The read and write implementations distinguish between trivial and
  *   non-trivial operations. A trivial operation corresponds to a read or
@@ -24,7 +28,8 @@
 #define CPPREG_ACCESSPOLICY_H
 
 
-#include "cppreg_Defines.h"
+#include "Atomic.h"
+#include "Internals.h"
 
 
 namespace cppreg {
@@ -179,6 +184,116 @@ struct RegisterWriteConstant {
 };
 
 
+//! Atomic register write implementation.
+/**
+ * @tparam MMIO Memory device type.
+ * @tparam T Register data type.
+ * @tparam mask Mask for the write operation.
+ * @tparam offset Offset for the write operation.
+ *
+ * This is the atomic counterpart of RegisterWrite: the non-trivial write
+ * (read-modify-write) is performed as an atomic update.
+ */
+template <typename MMIO, typename T, T mask, FieldOffset offset>
+struct AtomicRegisterWrite {
+
+    //! Non-trivial write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     * @param value Value to be written to the register field.
+     */
+    template <typename U = void>
+    static void write(MMIO& mmio_device,
+                      T value,    // NOLINTNEXTLINE
+                      is_not_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        const auto rhs = static_cast<T>(static_cast<T>(value << offset) & mask);
+        internals::atomic_modify<T>(mmio_device, [rhs](const T current) {
+            return static_cast<T>(
+                static_cast<T>(current & static_cast<T>(~mask)) | rhs);
+        });
+    }
+
+    //! Trivial write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     * @param value Value to be written to the register field.
+     *
+     * A write over the whole register is a single store and is atomic.
+     */
+    template <typename U = void>
+    static void write(MMIO& mmio_device,
+                      T value,    // NOLINTNEXTLINE
+                      is_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        mmio_device = value;
+    }
+};
+
+
+//! Atomic register write constant implementation.
+/**
+ * @tparam MMIO Memory device type.
+ * @tparam T Register data type.
+ * @tparam mask Mask for the write operation.
+ * @tparam offset Offset for the write operation.
+ * @tparam value Value to be written to the register field.
+ */
+template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+struct AtomicRegisterWriteConstant {
+
+    //! Non-trivial write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     */
+    template <typename U = void>
+    static void write(MMIO& mmio_device,    // NOLINTNEXTLINE
+                      is_not_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        internals::atomic_modify<T>(mmio_device, [](const T current) {
+            constexpr auto rhs =
+                static_cast<T>(static_cast<T>(value << offset) & mask);
+            return static_cast<T>(
+                static_cast<T>(current & static_cast<T>(~mask)) | rhs);
+        });
+    }
+
+    //! Trivial write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     */
+    template <typename U = void>
+    static void write(MMIO& mmio_device,    // NOLINTNEXTLINE
+                      is_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        mmio_device = value;
+    }
+};
+
+
+//! Register alias implementation.
+/**
+ * @tparam MMIO Memory device type.
+ * @tparam byte_offset Offset in bytes of the alias wrt the register.
+ *
+ * This is used to access alias registers (e.g., set/clear/toggle registers)
+ * located at a fixed offset from a register memory device.
+ */
+template <typename MMIO, std::ptrdiff_t byte_offset>
+struct RegisterAlias {
+
+    //! Alias memory device type.
+    using alias_type = MMIO;    // NOLINT
+
+    //! Alias memory device accessor.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     * @return A reference to the alias memory device.
+     */
+    static alias_type& get(MMIO& mmio_device) noexcept {
+        return *(reinterpret_cast<alias_type*>(    // NOLINT
+            reinterpret_cast<Address>(&mmio_device)
+            + static_cast<Address>(byte_offset)));
+    }
+};
+
+
 //! Read-only access policy.
 struct read_only {    // NOLINT
 
@@ -313,6 +428,425 @@ struct write_only {    // NOLINT
 };
 
 
+//! Write-1-to-clear access policy.
+/**
+ * This is intended for fields (typically status flags) that are cleared by
+ * writing 1 to them and for which writing 0 has no effect. The clear
+ * operation is a single store of the field mask (no read is performed);
+ * this avoids clearing other pending flags of the register, which would
+ * happen with a read-modify-write.
+ *
+ * The clear and write operations store the whole register with zero for all
+ * the bits outside of the field: this also writes zero to the read-write
+ * fields sharing the register. The policy should therefore only be used if
+ * writing 0 to the other fields of the register has no effect.
+ */
+struct write_1_to_clear : read_only {    // NOLINT
+
+    //! Clear field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(mmio_device);
+    }
+
+    //! Write access implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset
+     * @param mmio_device Pointer to register mapped memory.
+     * @param value Value to be written at the field location (bits set to 1
+     *              are cleared).
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, static_cast<T>((value << offset) & mask));
+    }
+
+    //! Write access implementation for constant value.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset
+     * @tparam value Value to be written at the field location (bits set to 1
+     *               are cleared).
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              static_cast<T>((value << offset) & mask)>::
+            write(mmio_device);
+    }
+};
+
+
+//! Write-1-to-set access policy.
+/**
+ * This is intended for fields that are set by writing 1 to them and for
+ * which writing 0 has no effect. The set operation is a single store of the
+ * field mask (no read is performed).
+ *
+ * As for write_1_to_clear, the set and write operations store the whole
+ * register with zero for all the bits outside of the field (including the
+ * read-write fields sharing the register).
+ */
+struct write_1_to_set : read_only {    // NOLINT
+
+    //! Set field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(mmio_device);
+    }
+
+    //! Write access implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset
+     * @param mmio_device Pointer to register mapped memory.
+     * @param value Value to be written at the field location (bits set to 1
+     *              are set).
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, static_cast<T>((value << offset) & mask));
+    }
+
+    //! Write access implementation for constant value.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset
+     * @tparam value Value to be written at the field location (bits set to 1
+     *               are set).
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              static_cast<T>((value << offset) & mask)>::
+            write(mmio_device);
+    }
+};
+
+
+//! Read-to-clear access policy.
+/**
+ * This is intended for fields that are cleared by hardware when read. The
+ * clear operation is a single read of the register (the value is
+ * discarded).
+ */
+struct read_to_clear : read_only {    // NOLINT
+
+    //! Clear field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        static_cast<void>(static_cast<T>(mmio_device));
+    }
+};
+
+
+//! Set/clear alias access policy.
+/**
+ * @tparam set_offset Offset in bytes of the set alias register.
+ * @tparam clear_offset Offset in bytes of the clear alias register.
+ *
+ * This is intended for read-write fields of registers that come with set
+ * and clear alias registers (e.g., GPIO output set/clear registers): writing
+ * 1 to a bit of an alias register sets or clears the corresponding bit of
+ * the register and writing 0 has no effect. The set and clear operations
+ * are then single stores of the field mask to the alias registers (no read
+ * is performed). The offsets are relative to the register address.
+ */
+template <std::ptrdiff_t set_offset, std::ptrdiff_t clear_offset>
+struct set_clear_alias : read_write {    // NOLINT
+
+    //! Set field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, set_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+
+    //! Clear field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, clear_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+};
+
+
+//! Set/clear/toggle alias access policy.
+/**
+ * @tparam set_offset Offset in bytes of the set alias register.
+ * @tparam clear_offset Offset in bytes of the clear alias register.
+ * @tparam toggle_offset Offset in bytes of the toggle alias register.
+ *
+ * This extends the set/clear alias policy for registers that also come with
+ * a toggle alias register; the toggle operation is then a single store of
+ * the field mask to the toggle alias register.
+ */
+template <std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset,
+          std::ptrdiff_t toggle_offset>
+struct set_clear_toggle_alias    // NOLINT
+    : set_clear_alias<set_offset, clear_offset> {
+
+    //! Toggle field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, toggle_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+};
+
+
+//! Bit-band read-write access policy.
+/**
+ * This is intended for single bit read-write fields of registers located in
+ * a bit-band region (Cortex-M3/M4). The field operations are performed
+ * through the bit-band alias word: set, clear and write are single stores
+ * (which are atomic with respect to interrupts) and read is a single load.
+ * The alias word is selected at compile time from the register address
+ * (see internals::register_policy), which is only possible for registers
+ * of the physical memory backend located in a bit-band region; otherwise
+ * (and for shadow values) the read-write policy implementation is used.
+ */
+struct bit_band_read_write : read_write {};    // NOLINT
+
+
+//! Atomic read-write access policy.
+/**
+ * This is intended for read-write fields that are modified from different
+ * execution contexts (e.g., thread and interrupt handler). The
+ * read-modify-write operations (write, set, clear and toggle) are performed
+ * as lock-free atomic updates (see Atomic.h), hence no critical section is
+ * required. Merge writes involving a field with this policy are also
+ * performed atomically. The policy is not available on ARM cores without
+ * exclusive access instructions (e.g., Cortex-M0/M0+), for which a critical
+ * section (e.g., masking interrupts) is required instead.
+ */
+struct atomic_read_write : read_only {    // NOLINT
+
+    //! Write access implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset.
+     * @param mmio_device Pointer to register mapped memory.
+     * @param value Value to be written at the field location.
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        AtomicRegisterWrite<MMIO, T, mask, offset>::write(mmio_device, value);
+    }
+
+    //! Write access implementation for constant value.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @tparam offset Field offset.
+     * @tparam value Value to be written at the field location.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO, T, mask, offset, value>::write(
+            mmio_device);
+    }
+
+    //! Set field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO, T, mask, FieldOffset{0}, mask>::
+            write(mmio_device);
+    }
+
+    //! Clear field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO,
+                                    T,
+                                    mask,
+                                    FieldOffset{0},
+                                    static_cast<T>(~mask)>::write(mmio_device);
+    }
+
+    //! Toggle field implementation.
+    /**
+     * @tparam MMIO Register memory device type.
+     * @tparam T Field data type.
+     * @tparam mask Field mask.
+     * @param mmio_device Pointer to register mapped memory.
+     */
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO& mmio_device) noexcept {
+        internals::atomic_modify<T>(mmio_device, [](const T current) {
+            return static_cast<T>(current ^ mask);
+        });
+    }
+};
+
+
+//! Atomic policy trait.
+/**
+ * @tparam P Access policy type.
+ *
+ * This will only derive from std::true_type if the policy is atomic.
+ */
+template <typename P>
+struct is_atomic_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<atomic_read_write, P>::value> {};
+
+
+//! Write-1 policy trait.
+/**
+ * @tparam P Access policy type.
+ *
+ * This will only derive from std::true_type if the policy is a
+ * write-1-to-clear or write-1-to-set policy (or is derived from one).
+ */
+template <typename P>
+struct is_write_1_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<write_1_to_clear, P>::value
+                                 || std::is_base_of<write_1_to_set,
+                                                    P>::value> {};
+
+
+//! Plain writable policy trait.
+/**
+ * @tparam P Access policy type.
+ *
+ * This will only derive from std::true_type if the fields can be written
+ * with plain writes of the register content, that is, if the policy is a
+ * read-write or write-only policy (or is derived from one).
+ */
+template <typename P>
+struct is_plain_writable_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<read_write, P>::value
+                                 || std::is_base_of<write_only, P>::value> {};
+
+
+namespace internals {
+
+//!@{ Alias policy detection (including derived policies).
+template <std::ptrdiff_t set_offset, std::ptrdiff_t clear_offset>
+std::true_type is_alias_policy_impl(    // NOLINT
+    const set_clear_alias<set_offset, clear_offset>*);
+std::false_type is_alias_policy_impl(const void*);    // NOLINT
+//!@}
+
+}    // namespace internals
+
+
+//! Shadow value compatible policy trait.
+/**
+ * @tparam P Access policy type.
+ *
+ * This will only derive from std::true_type if the policy can be used with
+ * a shadow value. The write-1-to-clear, write-1-to-set, read-to-clear and
+ * alias policies cannot: their operations are single accesses to the
+ * register (or to an alias register) which do not have the semantic of a
+ * write of the register content, and they cannot be applied to the shadow
+ * value.
+ */
+template <typename P>
+struct is_shadow_compatible_policy    // NOLINT
+    : std::integral_constant<
+          bool,
+          !std::is_base_of<write_1_to_clear, P>::value
+              && !std::is_base_of<write_1_to_set, P>::value
+              && !std::is_base_of<read_to_clear, P>::value
+              && !decltype(internals::is_alias_policy_impl(
+                  static_cast<const P*>(nullptr)))::value> {};
+
 }    // namespace cppreg
 
 
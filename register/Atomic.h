@@ -0,0 +1,167 @@
+//! Atomic read-modify-write implementation.
+/**
+ * @file      Atomic.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the lock-free read-modify-write implementation used
+ * by the atomic access policy. The implementation is selected based on the
+ * target:
+ * - for ARM cores with exclusive access instructions (e.g., ARMv7-M and
+ *   ARMv8-M mainline) a LDREX/STREX retry loop is used,
+ * - for ARM cores without exclusive access instructions (e.g., ARMv6-M and
+ *   ARMv8-M baseline) there is no lock-free implementation (the atomic
+ *   builtins would be library calls) and a compile-time error is generated,
+ * - for hosted targets with C++20 std::atomic_ref a compare-exchange loop
+ *   is used,
+ * - otherwise the GCC/Clang atomic builtins are used.
+ * No memory ordering is enforced (relaxed semantic).
+ */
+
+
+#ifndef CPPREG_ATOMIC_H
+#define CPPREG_ATOMIC_H
+
+
+#include "cppreg_Defines.h"
+
+#if !(defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)) \
+    && (__cplusplus >= 202002L)
+#include <atomic>
+#endif
+
+
+namespace cppreg {
+namespace internals {
+
+
+#if defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)
+
+//! Exclusive access implementation.
+/**
+ * @tparam T Data type.
+ *
+ * The generic implementation is for data types which are not supported by
+ * the exclusive access instructions of the target.
+ */
+template <typename T>
+struct exclusive_access {    // NOLINT
+    static_assert(sizeof(T) == 0,
+                  "exclusive_access:: data type not supported by target");
+};
+
+#if (__ARM_FEATURE_LDREX & 0x1)
+//! 8-bit specialization.
+template <>
+struct exclusive_access<std::uint8_t> {
+    static std::uint8_t load(volatile std::uint8_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrexb %0, %1" : "=r"(result) : "Q"(*addr));
+        return static_cast<std::uint8_t>(result);
+    }
+    static bool store(volatile std::uint8_t* addr,
+                      const std::uint8_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strexb %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(static_cast<std::uint32_t>(value)));
+        return result == 0U;
+    }
+};
+#endif    // __ARM_FEATURE_LDREX 8-bit
+
+#if (__ARM_FEATURE_LDREX & 0x2)
+//! 16-bit specialization.
+template <>
+struct exclusive_access<std::uint16_t> {
+    static std::uint16_t load(volatile std::uint16_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrexh %0, %1" : "=r"(result) : "Q"(*addr));
+        return static_cast<std::uint16_t>(result);
+    }
+    static bool store(volatile std::uint16_t* addr,
+                      const std::uint16_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strexh %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(static_cast<std::uint32_t>(value)));
+        return result == 0U;
+    }
+};
+#endif    // __ARM_FEATURE_LDREX 16-bit
+
+#if (__ARM_FEATURE_LDREX & 0x4)
+//! 32-bit specialization.
+template <>
+struct exclusive_access<std::uint32_t> {
+    static std::uint32_t load(volatile std::uint32_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrex %0, %1" : "=r"(result) : "Q"(*addr));
+        return result;
+    }
+    static bool store(volatile std::uint32_t* addr,
+                      const std::uint32_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strex %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(value));
+        return result == 0U;
+    }
+};
+#endif    // __ARM_FEATURE_LDREX 32-bit
+
+#endif    // __ARM_FEATURE_LDREX
+
+
+//! Atomic modify implementation.
+/**
+ * @tparam T Data type.
+ * @tparam Op Modifier type (callable as T(T)).
+ * @param mem Memory location to be modified.
+ * @param op Modifier computing the new value from the current one.
+ * @return The value before the modification.
+ *
+ * The modifier might be called more than once if the memory location is
+ * concurrently modified (e.g., by an interrupt handler).
+ */
+template <typename T, typename Op>
+inline T atomic_modify(volatile T& mem, Op op) noexcept {
+#if defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)
+    T current;
+    do {
+        current = exclusive_access<T>::load(&mem);
+    } while (!exclusive_access<T>::store(&mem, op(current)));
+    return current;
+#elif defined(__arm__)
+    static_assert(sizeof(T) == 0,
+                  "atomic_modify:: no lock-free atomic access on ARM cores "
+                  "without exclusive access instructions");
+#elif defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<T> ref(const_cast<T&>(mem));    // NOLINT
+    T current = ref.load(std::memory_order_relaxed);
+    while (!ref.compare_exchange_weak(
+        current, op(current), std::memory_order_relaxed)) {
+    }
+    return current;
+#elif defined(__GNUC__)
+    T current = __atomic_load_n(&mem, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&mem,
+                                        &current,
+                                        op(current),
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+    return current;
+#else
+    static_assert(sizeof(T) == 0,
+                  "atomic_modify:: atomic access not supported by target");
+#endif
+}
+
+
+}    // namespace internals
+}    // namespace cppreg
+
+
+#endif    // CPPREG_ATOMIC_H
@@ -0,0 +1,123 @@
+//! Memory ordering policies implementation.
+/**
+ * @file      Barrier.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the ordering policies which can be used to insert a
+ * barrier after a register write (e.g., with the merge write closure
+ * method). An ordering policy is a type providing a static function
+ * `void apply()`.
+ *
+ * For ARM cores implementing the DMB, DSB and ISB instructions (ARMv6-M,
+ * ARMv7 and later) the barriers are implemented with these instructions;
+ * otherwise (including older ARM cores) a sequentially consistent fence is
+ * used.
+ */
+
+
+#ifndef CPPREG_BARRIER_H
+#define CPPREG_BARRIER_H
+
+
+#include "cppreg_Defines.h"
+
+
+// Barrier instructions availability.
+#if defined(__aarch64__)                           \
+    || (defined(__arm__) && defined(__ARM_ARCH) \
+        && ((__ARM_ARCH >= 7) || defined(__ARM_ARCH_6M__)))
+#define CPPREG_ARM_BARRIER_INSTRUCTIONS
+#endif
+
+
+namespace cppreg {
+
+
+//! No barrier policy.
+struct no_barrier {    // NOLINT
+    static void apply() noexcept {}
+};
+
+
+//! Compiler barrier policy.
+/**
+ * This only prevents the compiler from moving memory accesses across the
+ * barrier (no instruction is emitted).
+ */
+struct compiler_barrier {    // NOLINT
+    static void apply() noexcept {
+        __asm__ volatile("" ::: "memory");
+    }
+};
+
+
+//! Data memory barrier policy.
+/**
+ * This guarantees that the memory accesses before the barrier are observed
+ * before the memory accesses after the barrier (e.g., when writing to
+ * different peripherals through a write buffer); it does not wait for the
+ * accesses to complete.
+ */
+struct dmb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dmb sy" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
+};
+
+
+//! Data synchronization barrier policy.
+/**
+ * This waits for the memory accesses before the barrier to complete (e.g.,
+ * after clearing an interrupt flag before returning from the interrupt
+ * handler, such that the interrupt is not taken again).
+ */
+struct dsb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dsb sy" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
+};
+
+
+//! Data and instruction synchronization barrier policy.
+/**
+ * This waits for the memory accesses before the barrier to complete and
+ * flushes the pipeline, such that the following instructions are executed
+ * with the effects of the accesses (e.g., after masking an interrupt or
+ * changing the memory configuration).
+ */
+struct dsb_isb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dsb sy\n\tisb" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
+};
+
+
+//! Memory barrier function.
+/**
+ * @tparam Ordering Ordering policy type.
+ *
+ * This can be used after field or register writes which require a barrier.
+ */
+template <typename Ordering>
+inline void memory_barrier() noexcept {
+    Ordering::apply();
+}
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_BARRIER_H
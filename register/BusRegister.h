@@ -0,0 +1,661 @@
+//! Bus register implementation.
+/**
+ * @file      BusRegister.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides registers for which the register width and the bus
+ * access width are specified separately (e.g., 24-bit registers or
+ * registers at unaligned offsets in a peripheral which only supports 32-bit
+ * aligned accesses). A bus register is accessed with the minimum number of
+ * aligned bus words covering it, the register value being extracted from
+ * (or inserted into) the words with shifts and masks.
+ */
+
+
+#ifndef CPPREG_BUSREGISTER_H
+#define CPPREG_BUSREGISTER_H
+
+
+#include "AccessPolicy.h"
+#include "Mask.h"
+#include "Memory.h"
+#include "MergeWrite.h"
+#include "RegisterValue.h"
+#include "ShadowValue.h"
+
+
+namespace cppreg {
+
+
+//! Bus access policy.
+/**
+ * @tparam bus_size Bus access size.
+ * @tparam exclusive_words Boolean flag indicating that the bits of the bus
+ * words which do not belong to the register are not used.
+ *
+ * By default, the bus words which are only partially covered by the register
+ * are read before being written (to preserve the bits of the neighboring
+ * registers). If exclusive_words is true these bits are written as zero and
+ * the writes are performed without reading (e.g., for a 24-bit register
+ * alone in a 32-bit word).
+ */
+template <RegBitSize bus_size = RegBitSize::b32, bool exclusive_words = false>
+struct bus_access {    // NOLINT
+
+    //! Bus access size.
+    constexpr static const auto size = bus_size;
+
+    //! Exclusive words flag.
+    constexpr static const bool exclusive = exclusive_words;
+};
+
+
+namespace internals {
+
+
+//! Bus words implementation.
+/**
+ * @tparam Device Memory device type.
+ * @tparam T Data type (wide enough for the register and the bus words).
+ * @tparam Bus Bus access policy type.
+ * @tparam first_offset Offset in bytes of the first word (device relative).
+ * @tparam shift Offset in bits of the register in the first word.
+ * @tparam width Register width in bits.
+ * @tparam index Word index.
+ * @tparam n_words Number of words.
+ *
+ * The words are accessed in ascending address order.
+ */
+template <typename Device,
+          typename T,
+          typename Bus,
+          std::size_t first_offset,
+          std::size_t shift,
+          std::size_t width,
+          std::size_t index,
+          std::size_t n_words>
+struct bus_words {    // NOLINT
+
+    //! Word data type.
+    using word_type = typename TypeTraits<Bus::size>::type;    // NOLINT
+
+    //! Word size in bits.
+    constexpr static const std::size_t word_bits =
+        TypeTraits<Bus::size>::bit_size;
+
+    //! Word offset in bytes (device relative).
+    constexpr static const std::size_t word_offset =
+        first_offset + (index * TypeTraits<Bus::size>::byte_size);
+
+    //!@{ Register bits in the word (register value is word >> right << left).
+    constexpr static const std::size_t right = (index == 0) ? shift : 0;
+    constexpr static const std::size_t left =
+        (index == 0) ? 0 : (index * word_bits) - shift;
+    constexpr static const std::size_t end =
+        ((shift + width - (index * word_bits)) < word_bits)
+            ? (shift + width - (index * word_bits))
+            : word_bits;
+    constexpr static const word_type mask =
+        make_shifted_mask<word_type>(static_cast<FieldWidth>(end - right),
+                                     static_cast<FieldOffset>(right));
+    //!@}
+
+    //! Next word.
+    using next =    // NOLINT
+        bus_words<Device,
+                  T,
+                  Bus,
+                  first_offset,
+                  shift,
+                  width,
+                  index + 1,
+                  n_words>;
+
+    //! Register bits of a value mask in the word.
+    /**
+     * @tparam value_mask Mask of register bits.
+     */
+    template <T value_mask>
+    using word_mask =    // NOLINT
+        std::integral_constant<
+            word_type,
+            static_cast<word_type>(
+                static_cast<word_type>(static_cast<T>(
+                    static_cast<T>(value_mask << right) >> left))
+                & mask)>;
+
+    //! Masked read method.
+    /**
+     * @tparam value_mask Mask of the register bits to be read.
+     * @return The register bits from this word and the next ones.
+     *
+     * The words without bits in the mask are not read.
+     */
+    template <T value_mask>
+    static T read() noexcept {
+        return static_cast<T>(
+            ((word_mask<value_mask>::value == word_type{0}) ? T{0}
+                                                             : read_word())
+            | next::template read<value_mask>());
+    }
+
+    //! Masked write method.
+    /**
+     * @tparam value_mask Mask of the register bits to be written.
+     * @param value Register value.
+     *
+     * The words without bits in the mask are not accessed. A word is
+     * written without reading it if all its bits are written (or all its
+     * register bits if the words are exclusive), and it is read and merged
+     * otherwise (one read and one write per word).
+     */
+    template <T value_mask>
+    static void write(const T value) noexcept {
+        constexpr auto written = word_mask<value_mask>::value;
+        const auto bits = static_cast<word_type>(
+            static_cast<word_type>(
+                static_cast<T>(static_cast<T>(value << right) >> left))
+            & written);
+        if (written == word_type{0}) {
+            // Nothing to write in this word.
+        } else if ((written == type_mask<word_type>::value)
+                   || (Bus::exclusive && (written == mask))) {
+            Device::template rw_memory<Bus::size, word_offset>() = bits;
+        } else {
+            const auto word = static_cast<word_type>(
+                Device::template ro_memory<Bus::size, word_offset>());
+            Device::template rw_memory<Bus::size, word_offset>() =
+                static_cast<word_type>(
+                    (word & static_cast<word_type>(~written)) | bits);
+        }
+        next::template write<value_mask>(value);
+    }
+
+private:
+    // Register bits of the word.
+    static T read_word() noexcept {
+        const auto word = static_cast<word_type>(
+            Device::template ro_memory<Bus::size, word_offset>());
+        return static_cast<T>(
+            static_cast<T>(static_cast<T>(word) >> right) << left);
+    }
+};
+template <typename Device,
+          typename T,
+          typename Bus,
+          std::size_t first_offset,
+          std::size_t shift,
+          std::size_t width,
+          std::size_t n_words>
+struct bus_words<Device,
+                 T,
+                 Bus,
+                 first_offset,
+                 shift,
+                 width,
+                 n_words,
+                 n_words> {    // NOLINT
+    template <T>
+    static T read() noexcept {
+        return T{0};
+    }
+    template <T>
+    static void write(const T) noexcept {}    // NOLINT
+};
+
+
+}    // namespace internals
+
+
+//! Bus register memory device.
+/**
+ * @tparam Device Memory device type (of the register pack).
+ * @tparam width Register width in bits.
+ * @tparam byte_offset Register offset in bytes (device relative).
+ * @tparam Bus Bus access policy type.
+ *
+ * This is the memory device type used by bus registers: conversion to the
+ * register data type reads the bus words covering the register and
+ * assignment writes them (see bus_access). The bus words are accessed
+ * through the pack memory device, such that all memory backends are
+ * supported; the atomic policy is not supported.
+ */
+template <typename Device,
+          std::uint8_t width,
+          std::size_t byte_offset,
+          typename Bus>
+class BusAccessRegister {
+
+public:
+    //! Register data type.
+    using type = typename WidthTraits<width>::type;    // NOLINT
+
+    //! Register address.
+    constexpr static const Address address = Device::base_address + byte_offset;
+
+    //! Bus word size in bytes.
+    constexpr static const std::size_t word_bytes =
+        TypeTraits<Bus::size>::byte_size;
+
+    //! Offset in bits of the register in the first bus word.
+    constexpr static const std::size_t shift =
+        (address % word_bytes) * one_byte;
+
+    //! Offset in bytes of the first bus word (device relative).
+    constexpr static const std::size_t first_offset =
+        byte_offset - (address % word_bytes);
+
+    //! Number of bus words per access.
+    constexpr static const std::size_t n_words =
+        (shift + width + TypeTraits<Bus::size>::bit_size - 1)
+        / TypeTraits<Bus::size>::bit_size;
+
+private:
+    // Data type wide enough for the register and a bus word.
+    using wide_type =    // NOLINT
+        typename std::conditional<(sizeof(type)
+                                   > sizeof(typename TypeTraits<
+                                            Bus::size>::type)),
+                                  type,
+                                  typename TypeTraits<Bus::size>::type>::type;
+
+    // Bus words implementation.
+    using words =    // NOLINT
+        internals::bus_words<Device,
+                             wide_type,
+                             Bus,
+                             first_offset,
+                             shift,
+                             width,
+                             0,
+                             n_words>;
+
+    // Register width mask.
+    constexpr static const type width_mask =
+        make_mask<type>(static_cast<FieldWidth>(width));
+
+    // Default constructor (only used by instance).
+    BusAccessRegister() = default;
+
+public:
+    //!@{ Non-copyable.
+    BusAccessRegister(const BusAccessRegister&) = delete;
+    BusAccessRegister& operator=(const BusAccessRegister&) = delete;
+    //!@}
+
+    //! Instance accessor.
+    static BusAccessRegister& instance() noexcept {
+        static BusAccessRegister reg;
+        return reg;
+    }
+
+    //! Read operator.
+    operator type() const noexcept {    // NOLINT
+        return read<width_mask>();
+    }
+
+    //! Write operator.
+    BusAccessRegister& operator=(const type value) noexcept {
+        write<width_mask>(value);
+        return *this;
+    }
+
+    //! Masked read method.
+    /**
+     * @tparam value_mask Mask of the register bits to be read.
+     * @return The register value (the bits outside of the mask are zero).
+     *
+     * Only the bus words containing bits of the mask are read.
+     */
+    template <type value_mask>
+    type read() const noexcept {
+        return static_cast<type>(
+            static_cast<type>(
+                words::template read<static_cast<wide_type>(value_mask)>())
+            & value_mask & width_mask);
+    }
+
+    //! Masked write method.
+    /**
+     * @tparam value_mask Mask of the register bits to be written.
+     * @param value Register value (the bits outside of the mask are
+     * ignored).
+     *
+     * Only the bus words containing bits of the mask are accessed (see
+     * internals::bus_words).
+     */
+    template <type value_mask>
+    void write(const type value) noexcept {
+        words::template write<static_cast<wide_type>(value_mask & width_mask)>(
+            static_cast<wide_type>(value));
+    }
+
+    // The bus words are aligned on the bus width.
+    static_assert(internals::is_aligned<Device::base_address,
+                                        word_bytes>::value,
+                  "BusAccessRegister:: device address is mis-aligned for "
+                  "bus accesses");
+};
+
+
+//! Register alias specialization for bus registers.
+/**
+ * The alias is the bus register at the alias offset in the same memory
+ * device.
+ */
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<BusAccessRegister<Device, width, reg_offset, Bus>,
+                     byte_offset> {
+
+    //! Alias memory device type.
+    using alias_type =    // NOLINT
+        BusAccessRegister<Device,
+                          width,
+                          static_cast<std::size_t>(
+                              static_cast<std::ptrdiff_t>(reg_offset)
+                              + byte_offset),
+                          Bus>;
+
+    //! Alias memory device accessor.
+    static alias_type& get(
+        BusAccessRegister<Device, width, reg_offset, Bus>&) noexcept {
+        return alias_type::instance();
+    }
+};
+
+
+//! Register read specialization for bus registers.
+/**
+ * Only the bus words containing bits of the mask are read.
+ */
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset>
+struct RegisterRead<BusAccessRegister<Device, width, reg_offset, Bus>,
+                    T,
+                    mask,
+                    offset> {
+
+    //! Memory device type.
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+
+    //! Read implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     * @return The content of the register field.
+     */
+    static T read(const MMIO& mmio_device) noexcept {
+        return static_cast<T>(
+            static_cast<T>(mmio_device.template read<mask>()) >> offset);
+    }
+};
+
+
+//! Register write specialization for bus registers.
+/**
+ * The register bits outside of the mask are not read: only the bus words
+ * containing bits of the mask are accessed, with one read-modify-write per
+ * partially written word (see internals::bus_words).
+ */
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset>
+struct RegisterWrite<BusAccessRegister<Device, width, reg_offset, Bus>,
+                     T,
+                     mask,
+                     offset> {
+
+    //! Memory device type.
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+
+    //! Write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     * @param value Value to be written to the register field.
+     */
+    static void write(MMIO& mmio_device, T value) noexcept {
+        mmio_device.template write<mask>(
+            static_cast<T>(static_cast<T>(value << offset) & mask));
+    }
+};
+
+
+//! Register write constant specialization for bus registers.
+/**
+ * This uses the register write specialization (see above).
+ */
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset,
+          T value>
+struct RegisterWriteConstant<
+    BusAccessRegister<Device, width, reg_offset, Bus>,
+    T,
+    mask,
+    offset,
+    value> {
+
+    //! Memory device type.
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+
+    //! Write implementation.
+    /**
+     * @param mmio_device Pointer to the register memory device.
+     */
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWrite<MMIO, T, mask, offset>::write(mmio_device, value);
+    }
+};
+
+
+//! Bus register implementation.
+/**
+ * @tparam RegisterPack Pack to which the register belongs.
+ * @tparam reg_width Register width in bits (1 to 64).
+ * @tparam bit_offset Offset in bits for the register with respect to base
+ * (multiple of 8).
+ * @tparam Bus Bus access policy type (see bus_access).
+ * @tparam reset_value Register reset value (0x0 if unknown).
+ * @tparam use_shadow Boolean flag to enable shadow value.
+ * @tparam use_shadow_read Boolean flag to serve reads from the shadow value.
+ *
+ * This implementation is intended to be used for registers which cannot be
+ * accessed with a single aligned access of their own size: the register
+ * data type is the narrowest type holding the register width and the
+ * register memory is accessed with the aligned bus words covering the
+ * register (e.g., a single 32-bit access for a 24-bit register at a 32-bit
+ * aligned offset, and two 32-bit accesses if it crosses a 32-bit boundary).
+ * The fields are defined as for the other registers. The pack base address
+ * has to be aligned on the bus width and the bus words have to be part of
+ * the pack.
+ */
+template <typename RegisterPack,
+          std::uint8_t reg_width,
+          std::uint32_t bit_offset,
+          typename Bus = bus_access<>,
+          typename WidthTraits<reg_width>::type reset_value = 0x0,
+          bool use_shadow = false,
+          bool use_shadow_read = false>
+struct BusRegister {
+
+    //! Register pack.
+    using pack = RegisterPack;    // NOLINT
+
+    //! Bus access policy.
+    using bus = Bus;    // NOLINT
+
+    //! Register base type.
+    using type = typename WidthTraits<reg_width>::type;    // NOLINT
+
+    //! Boolean flag for shadow value management.
+    using shadow = Shadow<BusRegister, use_shadow>;    // NOLINT
+
+    //! Boolean flag for shadow read management.
+    using shadow_read = ShadowRead<BusRegister, use_shadow_read>;    // NOLINT
+
+    //! Register base address.
+    constexpr static const Address base_address =
+        RegisterPack::pack_base + (bit_offset / one_byte);
+
+    //! Register size in bits.
+    constexpr static const auto size = WidthTraits<reg_width>::bit_size;
+
+    //! Register reset value.
+    constexpr static const auto reset = reset_value;
+
+    //! MMIO type (bus register memory device).
+    using MMIO =    // NOLINT
+        BusAccessRegister<
+            typename RegisterMemoryDevice<RegisterPack>::mem_device,
+            reg_width,
+            (bit_offset / one_byte),
+            Bus>;
+
+    //! Memory modifier.
+    /**
+     * @return A reference to the writable register memory.
+     */
+    static MMIO& rw_mem_device() noexcept {
+        return MMIO::instance();
+    }
+
+    //! Memory accessor.
+    /**
+     * @return A reference to the read-only register memory.
+     */
+    static const MMIO& ro_mem_device() noexcept {
+        return MMIO::instance();
+    }
+
+    //! Shadow value resynchronization.
+    /**
+     * This reloads the shadow value from the register memory (see
+     * Register::resync).
+     */
+    static void resync() noexcept {
+        static_assert(shadow_read::value,
+                      "BusRegister::resync:: shadow read is not enabled");
+        shadow::shadow_value = ro_mem_device();
+    }
+
+    //! Register value read function.
+    /**
+     * @return The register value (see Register::read_value).
+     */
+    static RegisterValue<BusRegister> read_value() noexcept {
+        return RegisterValue<BusRegister>::load();
+    }
+
+    //! Fields match function.
+    /**
+     * @tparam Conditions Field match conditions.
+     * @return `true` if all the conditions are satisfied, `false` otherwise
+     * (see Register::matches).
+     */
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+
+    //! Merge write start function.
+    /**
+     * @tparam F Field on which to perform the first write operation.
+     * @param value Value to be written to the field.
+     * @return A merge write data structure to chain further writes (see
+     * Register::merge_write).
+     */
+    template <typename F,
+              typename T =
+                  MergeWrite<typename F::parent_register,
+                             F::mask,
+                             is_atomic_policy<typename F::policy>::value>>
+    static T merge_write(const typename F::value_type value) noexcept {
+
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: field is not writable");
+
+        const auto lhs = static_cast<type>(static_cast<type>(value)
+                                           << F::offset);
+        return T::create(static_cast<type>(lhs & F::mask));
+    }
+
+    //! Merge write start function for constant value.
+    /**
+     * @tparam F Field on which to perform the first write operation.
+     * @tparam value Value to be written to the field.
+     * @return A merge write data structure to chain further writes (see
+     * Register::merge_write).
+     */
+    template <typename F,
+              typename F::value_type value,
+              typename T = MergeWrite_tmpl<
+                  typename F::parent_register,
+                  F::mask,
+                  F::offset,
+                  static_cast<type>(value),
+                  is_atomic_policy<typename F::policy>::value>>
+    static T merge_write() noexcept {
+
+        // Check overflow.
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "BusRegister::merge_write<value>:: value too large for the field");
+
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: field is not writable");
+
+        return T::create();
+    }
+
+    // Shadow read requires a shadow value.
+    static_assert(use_shadow || !use_shadow_read,
+                  "BusRegister:: shadow read requires shadow value to be "
+                  "enabled");
+
+    // The register offset is in bytes.
+    static_assert((bit_offset % one_byte) == 0,
+                  "BusRegister:: offset is not a multiple of 8 bits");
+
+    // Safety checks to detect if are overflowing the pack.
+    static_assert((bit_offset / one_byte) + WidthTraits<reg_width>::byte_size
+                      <= RegisterPack::size_in_bytes,
+                  "BusRegister:: register is overflowing the pack");
+    static_assert(MMIO::first_offset + (MMIO::n_words * MMIO::word_bytes)
+                      <= RegisterPack::size_in_bytes,
+                  "BusRegister:: bus words are overflowing the pack");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_BUSREGISTER_H
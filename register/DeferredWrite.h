@@ -0,0 +1,335 @@
+//! Deferred write implementation.
+/**
+ * @file      DeferredWrite.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * A deferred write accumulates runtime field writes to several registers of
+ * the same pack (one pending value and mask per register, similarly to the
+ * merge write implementation) and performs all of them when flushed. This
+ * makes it possible to compute the content of several registers over a
+ * scope and to write them as a tight burst of stores (e.g., for registers
+ * which are latched by the hardware on the next period).
+ */
+
+
+#ifndef CPPREG_DEFERREDWRITE_H
+#define CPPREG_DEFERREDWRITE_H
+
+
+#include "AccessPolicy.h"
+#include "Barrier.h"
+#include "Internals.h"
+
+
+namespace cppreg {
+
+
+namespace internals {
+
+
+//! Deferred write entry.
+/**
+ * @tparam Register Register to be written.
+ *
+ * This holds the pending writes to a given register: the pending value
+ * (already shifted and masked) and the combined mask of the written fields.
+ */
+template <typename Register>
+struct deferred_write_entry {    // NOLINT
+
+    //! Register data type.
+    using type = typename Register::type;    // NOLINT
+
+    //! Pending value.
+    type pending_value;
+
+    //! Pending mask.
+    type pending_mask;
+
+    //! Boolean flag indicating that a pending field is not write-only.
+    bool pending_read;
+
+    //! Default constructor (no pending write).
+    deferred_write_entry() noexcept
+        : pending_value{0}, pending_mask{0}, pending_read{false} {};
+
+    //! Update method.
+    /**
+     * @param mask Field mask.
+     * @param value Field value (already shifted).
+     * @param write_only Boolean flag indicating a write-only field.
+     */
+    void update(const type mask,
+                const type value,
+                const bool write_only) noexcept {
+        pending_value = static_cast<type>(
+            (pending_value & static_cast<type>(~mask)) | (value & mask));
+        pending_mask = static_cast<type>(pending_mask | mask);
+        pending_read = pending_read || !write_only;
+    }
+
+    //!@{ Helpers for merge method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
+
+    //! Merge method (no shadow value).
+    /**
+     * This computes the value to be stored. If the pending mask covers the
+     * whole register, or if all the pending fields are write-only (the other
+     * bits are then written as 0, see write_only), no read is performed;
+     * otherwise the register memory is read and merged with the pending
+     * value.
+     */
+    template <typename T = void>
+    void merge(if_no_shadow<T>* = nullptr) noexcept {    // NOLINT
+        if (pending_read && (pending_mask != type_mask<type>::value)) {
+            const type current = Register::ro_mem_device();
+            pending_value = static_cast<type>(
+                (current & static_cast<type>(~pending_mask)) | pending_value);
+        }
+    }
+
+    //! Merge method (w/ shadow value).
+    /**
+     * The pending value is merged into the shadow value, which is the value
+     * to be stored (no read is performed).
+     */
+    template <typename T = void>
+    void merge(if_shadow<T>* = nullptr) noexcept {    // NOLINT
+        if (pending_mask != type{0}) {
+            Register::shadow::shadow_value = static_cast<type>(
+                (Register::shadow::shadow_value
+                 & static_cast<type>(~pending_mask))
+                | pending_value);
+            pending_value = Register::shadow::shadow_value;
+        }
+    }
+
+    //! Store method.
+    /**
+     * This writes the merged value to the whole register (single store) and
+     * clears the pending writes.
+     */
+    void store() noexcept {
+        if (pending_mask != type{0}) {
+            RegisterWrite<typename Register::MMIO,
+                          type,
+                          type_mask<type>::value,
+                          FieldOffset{0}>::write(Register::rw_mem_device(),
+                                                 pending_value);
+            discard();
+        }
+    }
+
+    //! Pending writes accessor.
+    bool is_pending() const noexcept {
+        return pending_mask != type{0};
+    }
+
+    //! Discard method.
+    void discard() noexcept {
+        pending_value = type{0};
+        pending_mask = type{0};
+        pending_read = false;
+    }
+};
+
+
+}    // namespace internals
+
+
+//! Deferred write implementation.
+/**
+ * @tparam RegisterPack Pack to which the registers belong.
+ * @tparam Registers Registers which can be written (e.g., PackedRegister
+ * types from the pack).
+ *
+ * The field writes are accumulated in one pending value and mask per
+ * register and no register memory access is performed until flush() is
+ * called. When flushed:
+ * - the values to be stored are first computed for all the registers with
+ *   pending writes (registers which are not entirely written are read, and
+ *   shadow values are updated),
+ * - the registers are then written with one store each, in the order of the
+ *   Registers list.
+ *
+ * The pending writes are discarded if the deferred write is destroyed
+ * before being flushed. The writes are not atomic: fields using an atomic
+ * access policy are not supported. The fields are also required to be
+ * writable with plain writes (read-write or write-only policies). A
+ * register whose pending fields are all write-only is not read: as with
+ * Field::write, the other bits are written as 0.
+ */
+template <typename RegisterPack, typename... Registers>
+class DeferredWrite    // NOLINT
+    : private internals::deferred_write_entry<Registers>... {
+
+private:
+    // Entry accessor.
+    template <typename F>
+    internals::deferred_write_entry<typename F::parent_register>&
+    entry() noexcept {
+        static_assert(
+            std::is_base_of<
+                internals::deferred_write_entry<typename F::parent_register>,
+                DeferredWrite>::value,
+            "DeferredWrite:: field register is not in the registers list");
+        static_assert(!is_atomic_policy<typename F::policy>::value,
+                      "DeferredWrite:: atomic fields are not supported");
+        static_assert(
+            !std::is_base_of<write_1_to_clear, typename F::policy>::value
+                && !std::is_base_of<write_1_to_set,
+                                    typename F::policy>::value,
+            "DeferredWrite:: write-1-to-clear/set fields are not supported");
+        static_assert(
+            std::is_base_of<read_write, typename F::policy>::value
+                || std::is_base_of<write_only, typename F::policy>::value,
+            "DeferredWrite:: field is not writable");
+        return *this;
+    }
+
+    // Write-only field check.
+    template <typename F>
+    using is_write_only =    // NOLINT
+        std::is_base_of<write_only, typename F::policy>;
+
+    // Field value shifted and masked.
+    template <typename F>
+    static typename F::type shifted(const typename F::type value) noexcept {
+        return static_cast<typename F::type>(
+            static_cast<typename F::type>(value << F::offset) & F::mask);
+    }
+
+public:
+    //! Default constructor (no pending write).
+    DeferredWrite() = default;
+
+    //! Field write method.
+    /**
+     * @tparam F Field type.
+     * @param value Value to be written to the field.
+     * @return A reference to the deferred write (to chain calls).
+     */
+    template <typename F>
+    DeferredWrite& write(const typename F::value_type value) noexcept {
+        entry<F>().update(F::mask,
+                          shifted<F>(static_cast<typename F::type>(value)),
+                          is_write_only<F>::value);
+        return *this;
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam F Field type.
+     * @tparam value Constant to be written to the field.
+     * @return A reference to the deferred write (to chain calls).
+     */
+    template <typename F, typename F::value_type value>
+    DeferredWrite& write() noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "DeferredWrite::write<value>: value too large for the field");
+
+        return write<F>(value);
+    }
+
+    //! Field set method.
+    /**
+     * @tparam F Field type.
+     * @return A reference to the deferred write (to chain calls).
+     */
+    template <typename F>
+    DeferredWrite& set() noexcept {
+        entry<F>().update(F::mask, F::mask, is_write_only<F>::value);
+        return *this;
+    }
+
+    //! Field clear method.
+    /**
+     * @tparam F Field type.
+     * @return A reference to the deferred write (to chain calls).
+     */
+    template <typename F>
+    DeferredWrite& clear() noexcept {
+        entry<F>().update(
+            F::mask, typename F::type{0}, is_write_only<F>::value);
+        return *this;
+    }
+
+    //! Pending writes accessor.
+    /**
+     * @return `true` if there are pending writes, `false` otherwise.
+     */
+    bool pending() const noexcept {
+        bool result = false;
+        const int expand[] = {
+            0,
+            (result = result
+                      || static_cast<const internals::deferred_write_entry<
+                          Registers>&>(*this)
+                             .is_pending(),
+             0)...};
+        static_cast<void>(expand);
+        return result;
+    }
+
+    //! Flush method.
+    /**
+     * @tparam Ordering Ordering policy applied after the stores.
+     *
+     * This is where the writes happen (one store per register with pending
+     * writes); the pending writes are then cleared.
+     */
+    template <typename Ordering = no_barrier>
+    void flush() noexcept {
+        // The initializer lists guarantee the evaluation order: all the
+        // reads are performed before the first store.
+        const int merge_expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .merge(),
+             0)...};
+        const int store_expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .store(),
+             0)...};
+        static_cast<void>(merge_expand);
+        static_cast<void>(store_expand);
+        Ordering::apply();
+    }
+
+    //! Discard method.
+    /**
+     * This clears the pending writes without accessing the registers.
+     */
+    void discard() noexcept {
+        const int expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .discard(),
+             0)...};
+        static_cast<void>(expand);
+    }
+
+    // Safety check.
+    static_assert(
+        internals::is_pack_registers<RegisterPack, Registers...>::value,
+        "DeferredWrite:: register is not from the same pack");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_DEFERREDWRITE_H
@@ -17,6 +17,9 @@
 #include "AccessPolicy.h"
 #include "Internals.h"
 #include "Mask.h"
+#include "Memory.h"
+#include "RegisterValue.h"
+#include "Wait.h"
 
 
 namespace cppreg {
@@ -48,12 +51,20 @@ struct Field {
     //! Field data type derived from register data type.
     using type = typename parent_register::type;    // NOLINT
 
+    //! Field value type (see EnumField).
+    using value_type = type;    // NOLINT
+
     //! MMIO type.
     using MMIO = typename parent_register::MMIO;    // NOLINT
 
     //! Field policy.
     using policy = AccessPolicy;    // NOLINT
 
+    //! Field policy implementation for the register memory.
+    using mem_policy =    // NOLINT
+        typename internals::register_policy<AccessPolicy,
+                                            parent_register>::type;
+
     //! Field width.
     constexpr static auto width = field_width;
 
@@ -63,6 +74,13 @@ struct Field {
     //! Field mask.
     constexpr static auto mask = make_shifted_mask<type>(width, offset);
 
+    //!@{ Match conditions (see Register::matches).
+    template <type value>
+    using eq = internals::field_match<Field, value>;    // NOLINT
+    using all_set = eq<(mask >> offset)>;               // NOLINT
+    using all_clear = eq<0>;                            // NOLINT
+    //!@}
+
     //!@{ Helpers for write method selection based on shadow value.
     template <type value, typename T>
     using if_no_shadow =    // NOLINT
@@ -72,22 +90,62 @@ struct Field {
         typename std::enable_if<parent_register::shadow::value, T>::type;
     //!@}
 
+    //!@{ Helpers for read and RMW method selection based on shadow read.
+    template <typename T>
+    using if_no_shadow_read =    // NOLINT
+        typename std::enable_if<!parent_register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_shadow_read =    // NOLINT
+        typename std::enable_if<parent_register::shadow_read::value, T>::type;
+    //!@}
+
+    //!@{ Helpers for read method selection based on shadow read.
+    /**
+     * Only the read-write fields are served from the shadow value: the other
+     * fields (e.g., read-only status fields) are modified by the hardware
+     * and are always read from the register memory.
+     */
+    template <typename T>
+    using if_memory_read =    // NOLINT
+        typename std::enable_if<
+            !parent_register::shadow_read::value
+                || !std::is_base_of<read_write, AccessPolicy>::value,
+            T>::type;
+    template <typename T>
+    using if_shadow_value_read =    // NOLINT
+        typename std::enable_if<
+            parent_register::shadow_read::value
+                && std::is_base_of<read_write, AccessPolicy>::value,
+            T>::type;
+    //!@}
+
     //!@ Field read method.
     /**
      * @return Field value.
      */
-    static type read() noexcept {
-        return policy::template read<MMIO, type, mask, offset>(
+    template <typename T = type>
+    static T read(if_memory_read<T>* = nullptr) noexcept {    // NOLINT
+        return mem_policy::template read<MMIO, type, mask, offset>(
             parent_register::ro_mem_device());
     }
 
+    //!@ Field read method (w/ shadow read, read-write fields).
+    /**
+     * @return Field value (from the shadow value).
+     */
+    template <typename T = type>
+    static T read(if_shadow_value_read<T>* = nullptr) noexcept {    // NOLINT
+        return policy::template read<type, type, mask, offset>(
+            parent_register::shadow::shadow_value);
+    }
+
     //! Field write value method (no shadow value).
     /**
      * @param value Value to be written to the field.
      */
     template <typename T = type>
     static void write(const if_no_shadow<type{0}, T> value) noexcept {
-        policy::template write<MMIO, type, mask, offset>(
+        mem_policy::template write<MMIO, type, mask, offset>(
             parent_register::rw_mem_device(), value);
     }
 
@@ -104,10 +162,7 @@ struct Field {
 
         // Write as a block to the register, that is, we do not use the
         // field mask and field offset.
-        policy::
-            template write<MMIO, type, type_mask<type>::value, FieldOffset{0}>(
-                parent_register::rw_mem_device(),
-                parent_register::shadow::shadow_value);
+        write_shadow_value();
     }
 
     //! Field write constant method (no shadow value).
@@ -119,7 +174,7 @@ struct Field {
      */
     template <type value, typename T = void>
     static void write(if_no_shadow<value, T>* = nullptr) noexcept {    // NOLINT
-        policy::template write<MMIO, type, mask, offset, value>(
+        mem_policy::template write<MMIO, type, mask, offset, value>(
             parent_register::rw_mem_device());
 
         // Check for overflow.
@@ -151,29 +206,68 @@ struct Field {
     /**
      * This method will set all bits in the field.
      */
-    static void set() noexcept {
-        policy::template set<MMIO, type, mask>(
+    template <typename T = void>
+    static void set(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template set<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
 
+    //! Field set method (w/ shadow read).
+    /**
+     * This method will set all bits in the field of the shadow value and
+     * write the shadow value as a block to the register.
+     */
+    template <typename T = void>
+    static void set(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template set<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
+
     //! Field clear method.
     /**
      * This method will clear all bits in the field.
      */
-    static void clear() noexcept {
-        policy::template clear<MMIO, type, mask>(
+    template <typename T = void>
+    static void clear(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template clear<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
 
+    //! Field clear method (w/ shadow read).
+    /**
+     * This method will clear all bits in the field of the shadow value and
+     * write the shadow value as a block to the register.
+     */
+    template <typename T = void>
+    static void clear(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template clear<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
+
     //! Field toggle method.
     /**
      * This method will toggle all bits in the field.
      */
-    static void toggle() noexcept {
-        policy::template toggle<MMIO, type, mask>(
+    template <typename T = void>
+    static void toggle(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template toggle<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
 
+    //! Field toggle method (w/ shadow read).
+    /**
+     * This method will toggle all bits in the field of the shadow value and
+     * write the shadow value as a block to the register.
+     */
+    template <typename T = void>
+    static void toggle(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template toggle<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
+
     //! Is field set bool method.
     /**
      * @return `true` if all the bits are set to 1, `false` otherwise.
@@ -190,6 +284,102 @@ struct Field {
         return (Field::read() == type{0});
     }
 
+    //! Wait until field is equal to a value method.
+    /**
+     * @tparam value Value to wait for.
+     * @tparam Wait Wait policy type (called at each iteration).
+     *
+     * The polling loop is performed on the masked register word (i.e., a
+     * single load, test and branch per iteration). The register memory is
+     * always read (even if the reads are served from the shadow value).
+     */
+    template <type value, typename Wait = busy_wait>
+    static void wait_until_equal() noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "Field::wait_until_equal<value>: value too large for the field");
+
+        while (!is_equal_raw<value>()) {
+            Wait::pause();
+        }
+    }
+
+    //! Wait until field is equal to a value method (w/ timeout).
+    /**
+     * @tparam value Value to wait for.
+     * @tparam Clock Tick source type.
+     * @tparam Wait Wait policy type (called at each iteration).
+     * @param timeout Timeout in ticks.
+     * @return `true` if the field is equal to the value, `false` if the
+     * timeout expired.
+     */
+    template <type value, typename Clock, typename Wait = busy_wait>
+    static bool wait_until_equal(
+        const typename Clock::tick_type timeout) noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "Field::wait_until_equal<value>: value too large for the field");
+
+        const auto start = Clock::now();
+        while (!is_equal_raw<value>()) {
+            if (static_cast<typename Clock::tick_type>(Clock::now() - start)
+                >= timeout) {
+                // Check once more in case we got preempted.
+                return is_equal_raw<value>();
+            }
+            Wait::pause();
+        }
+        return true;
+    }
+
+    //! Wait until field is set method.
+    /**
+     * @tparam Wait Wait policy type (called at each iteration).
+     */
+    template <typename Wait = busy_wait>
+    static void wait_until_set() noexcept {
+        wait_until_equal<(mask >> offset), Wait>();
+    }
+
+    //! Wait until field is set method (w/ timeout).
+    /**
+     * @tparam Clock Tick source type.
+     * @tparam Wait Wait policy type (called at each iteration).
+     * @param timeout Timeout in ticks.
+     * @return `true` if the field is set, `false` if the timeout expired.
+     */
+    template <typename Clock, typename Wait = busy_wait>
+    static bool wait_until_set(
+        const typename Clock::tick_type timeout) noexcept {
+        return wait_until_equal<(mask >> offset), Clock, Wait>(timeout);
+    }
+
+    //! Wait until field is clear method.
+    /**
+     * @tparam Wait Wait policy type (called at each iteration).
+     */
+    template <typename Wait = busy_wait>
+    static void wait_until_clear() noexcept {
+        wait_until_equal<type{0}, Wait>();
+    }
+
+    //! Wait until field is clear method (w/ timeout).
+    /**
+     * @tparam Clock Tick source type.
+     * @tparam Wait Wait policy type (called at each iteration).
+     * @param timeout Timeout in ticks.
+     * @return `true` if the field is clear, `false` if the timeout expired.
+     */
+    template <typename Clock, typename Wait = busy_wait>
+    static bool wait_until_clear(
+        const typename Clock::tick_type timeout) noexcept {
+        return wait_until_equal<type{0}, Clock, Wait>(timeout);
+    }
+
     // Consistency checking.
     // The width of the field cannot exceed the register size and the
     // width added to the offset cannot exceed the register size.
@@ -199,6 +389,152 @@ struct Field {
                   "Field:: offset + width is larger than parent register size");
     static_assert(width != FieldWidth{0},
                   "Field:: defining a Field type of zero width is not allowed");
+
+    // The shadow value cannot model the policies operating on the register
+    // memory only (e.g., write-1-to-clear or alias policies).
+    static_assert(!parent_register::shadow::value
+                      || is_shadow_compatible_policy<AccessPolicy>::value,
+                  "Field:: access policy is not supported with shadow value");
+
+    // The bit-band policy accesses the alias word of a single bit.
+    static_assert(!std::is_base_of<bit_band_read_write, AccessPolicy>::value
+                      || ((mask != type{0})
+                          && ((mask & (mask - 1U)) == type{0})),
+                  "Field:: bit-band requires a single bit field");
+
+    // The alias registers have to be accessible with the memory backend.
+    static_assert(internals::is_policy_alias_in_memory<parent_register>(
+                      static_cast<const AccessPolicy*>(nullptr)),
+                  "Field:: alias register is outside of the pack memory");
+
+private:
+    // Raw field comparison (used by polling loops).
+    // This compares the masked register word with the shifted value, which
+    // avoids shifting the register content at each polling iteration.
+    template <type value>
+    static bool is_equal_raw() noexcept {
+
+        // The field has to be readable.
+        static_assert(
+            std::is_same<decltype(policy::template read<MMIO,
+                                                        type,
+                                                        mask,
+                                                        offset>(
+                             parent_register::ro_mem_device())),
+                         type>::value,
+            "Field::wait_until:: field is not readable");
+
+        return RegisterRead<MMIO, type, mask, FieldOffset{0}>::read(
+                   parent_register::ro_mem_device())
+               == static_cast<type>(value << offset);
+    }
+
+    // Shadow value block write.
+    // This writes the shadow value to the whole register, that is, we do not
+    // use the field mask and field offset.
+    static void write_shadow_value() noexcept {
+        policy::
+            template write<MMIO, type, type_mask<type>::value, FieldOffset{0}>(
+                parent_register::rw_mem_device(),
+                parent_register::shadow::shadow_value);
+    }
+};
+
+
+//! Register field with enumerated values implementation.
+/**
+ * @tparam BaseRegister Parent register.
+ * @tparam width Field width.
+ * @tparam offset Field offset.
+ * @tparam P Access policy type.
+ * @tparam Enum Enumeration type of the field values.
+ *
+ * This is a field for which the values are given by an enumeration: the
+ * read method returns an enumerator and the write and comparison methods
+ * take enumerators (instead of raw values). The enumeration type is also
+ * used by the merge write and register value methods (see value_type),
+ * such that constant writes are still performed with the constant write
+ * implementation.
+ */
+template <typename BaseRegister,
+          FieldWidth field_width,
+          FieldOffset field_offset,
+          typename AccessPolicy,
+          typename Enum>
+struct EnumField
+    : Field<BaseRegister, field_width, field_offset, AccessPolicy> {
+
+    //! Base field type.
+    using base_field =    // NOLINT
+        Field<BaseRegister, field_width, field_offset, AccessPolicy>;
+
+    //! Field data type derived from register data type.
+    using type = typename base_field::type;    // NOLINT
+
+    //! Field value type.
+    using value_type = Enum;    // NOLINT
+
+    //! Match condition (see Register::matches).
+    template <Enum value>
+    using eq =    // NOLINT
+        internals::field_match<EnumField, static_cast<type>(value)>;
+
+    //! Field read method.
+    /**
+     * @return Field value.
+     */
+    static Enum read() noexcept {
+        return static_cast<Enum>(base_field::read());
+    }
+
+    //! Field write value method.
+    /**
+     * @param value Value to be written to the field.
+     */
+    static void write(const Enum value) noexcept {
+        base_field::write(static_cast<type>(value));
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam value Constant to be written to the field.
+     */
+    template <Enum value>
+    static void write() noexcept {
+        base_field::template write<static_cast<type>(value)>();
+    }
+
+    //! Wait until field is equal to a value method.
+    /**
+     * @tparam value Value to wait for.
+     * @tparam Wait Wait policy type (called at each iteration).
+     */
+    template <Enum value, typename Wait = busy_wait>
+    static void wait_until_equal() noexcept {
+        base_field::template wait_until_equal<static_cast<type>(value),
+                                              Wait>();
+    }
+
+    //! Wait until field is equal to a value method (w/ timeout).
+    /**
+     * @tparam value Value to wait for.
+     * @tparam Clock Tick source type.
+     * @tparam Wait Wait policy type (called at each iteration).
+     * @param timeout Timeout in ticks.
+     * @return `true` if the field is equal to the value, `false` if the
+     * timeout expired.
+     */
+    template <Enum value, typename Clock, typename Wait = busy_wait>
+    static bool wait_until_equal(
+        const typename Clock::tick_type timeout) noexcept {
+        return base_field::template wait_until_equal<static_cast<type>(value),
+                                                     Clock,
+                                                     Wait>(timeout);
+    }
+
+    // Enumeration check.
+    static_assert(std::is_enum<Enum>::value,
+                  "EnumField:: value type is not an enumeration");
 };
 
 
@@ -0,0 +1,184 @@
+//! FIFO register implementation.
+/**
+ * @file      FifoRegister.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides block accesses to FIFO data registers (e.g., UART
+ * or SPI data registers), that is, a buffer is written to or read from a
+ * fixed register address. The bursts can be gated on a field holding the
+ * FIFO level, or delegated to a transfer hook (e.g., a DMA transfer).
+ *
+ * A transfer hook is a type providing the static functions
+ * `void write(Address, const T*, std::size_t)` and
+ * `void read(Address, T*, std::size_t)`, where the address is the register
+ * address and the last argument is the number of elements.
+ */
+
+
+#ifndef CPPREG_FIFOREGISTER_H
+#define CPPREG_FIFOREGISTER_H
+
+
+#include "Internals.h"
+#include "Wait.h"
+
+
+namespace cppreg {
+
+
+//! FIFO register implementation.
+/**
+ * @tparam Register FIFO data register type.
+ * @tparam T Elements data type (e.g., std::uint8_t for a 8-bit data field in
+ * a 32-bit register).
+ *
+ * Each element is written to (or read from) the whole register with a
+ * single access; the loops are unrolled and the register memory is only
+ * obtained once per burst.
+ */
+template <typename Register, typename T = typename Register::type>
+struct FifoRegister {
+
+    //! Register type.
+    using reg = Register;    // NOLINT
+
+    //! Register data type.
+    using type = typename Register::type;    // NOLINT
+
+    //! Elements data type.
+    using value_type = T;    // NOLINT
+
+    //! MMIO type.
+    using MMIO = typename Register::MMIO;    // NOLINT
+
+    //! Register address (e.g., for a DMA transfer).
+    constexpr static const Address address = Register::base_address;
+
+    //! Number of accesses per unrolled loop iteration.
+    constexpr static const std::size_t unroll = 4U;
+
+    //! Burst write method.
+    /**
+     * @param data Elements to be written.
+     * @param n Number of elements.
+     */
+    static void write_burst(const T* data, std::size_t n) noexcept {
+        MMIO& mmio_device = Register::rw_mem_device();
+        for (; n >= unroll; n -= unroll, data += unroll) {
+            mmio_device = static_cast<type>(data[0]);
+            mmio_device = static_cast<type>(data[1]);
+            mmio_device = static_cast<type>(data[2]);
+            mmio_device = static_cast<type>(data[3]);
+        }
+        for (; n != 0U; --n, ++data) {
+            mmio_device = static_cast<type>(*data);
+        }
+    }
+
+    //! Burst read method.
+    /**
+     * @param out Buffer for the elements read.
+     * @param n Number of elements.
+     */
+    static void read_burst(T* out, std::size_t n) noexcept {
+        const MMIO& mmio_device = Register::ro_mem_device();
+        for (; n >= unroll; n -= unroll, out += unroll) {
+            out[0] = static_cast<T>(static_cast<type>(mmio_device));
+            out[1] = static_cast<T>(static_cast<type>(mmio_device));
+            out[2] = static_cast<T>(static_cast<type>(mmio_device));
+            out[3] = static_cast<T>(static_cast<type>(mmio_device));
+        }
+        for (; n != 0U; --n, ++out) {
+            *out = static_cast<T>(static_cast<type>(mmio_device));
+        }
+    }
+
+    //! Gated burst write method.
+    /**
+     * @tparam Level Field holding the number of elements in the FIFO.
+     * @tparam depth FIFO depth.
+     * @tparam Wait Wait policy type (called while the FIFO is full).
+     * @param data Elements to be written.
+     * @param n Number of elements.
+     *
+     * The level is read before each burst and the burst size is limited to
+     * the free space in the FIFO. This returns once all the elements have
+     * been written.
+     */
+    template <typename Level, std::size_t depth, typename Wait = busy_wait>
+    static void write_burst(const T* data, std::size_t n) noexcept {
+        while (n != 0U) {
+            std::size_t level = Level::read();
+            while (level >= depth) {
+                Wait::pause();
+                level = Level::read();
+            }
+            const std::size_t count = (depth - level < n) ? depth - level : n;
+            write_burst(data, count);
+            data += count;
+            n -= count;
+        }
+    }
+
+    //! Gated burst read method.
+    /**
+     * @tparam Level Field holding the number of elements in the FIFO.
+     * @tparam Wait Wait policy type (called while the FIFO is empty).
+     * @param out Buffer for the elements read.
+     * @param n Number of elements.
+     *
+     * The level is read before each burst and the burst size is limited to
+     * the number of elements in the FIFO. This returns once all the
+     * elements have been read.
+     */
+    template <typename Level, typename Wait = busy_wait>
+    static void read_burst(T* out, std::size_t n) noexcept {
+        while (n != 0U) {
+            std::size_t level = Level::read();
+            while (level == 0U) {
+                Wait::pause();
+                level = Level::read();
+            }
+            const std::size_t count = (level < n) ? level : n;
+            read_burst(out, count);
+            out += count;
+            n -= count;
+        }
+    }
+
+    //! Transfer write method.
+    /**
+     * @tparam Transfer Transfer hook type.
+     * @param data Elements to be written.
+     * @param n Number of elements.
+     *
+     * This delegates the burst to the transfer hook (e.g., to start a DMA
+     * transfer to the register address).
+     */
+    template <typename Transfer>
+    static void transfer_write(const T* data, const std::size_t n) noexcept {
+        Transfer::write(address, data, n);
+    }
+
+    //! Transfer read method.
+    /**
+     * @tparam Transfer Transfer hook type.
+     * @param out Buffer for the elements read.
+     * @param n Number of elements.
+     */
+    template <typename Transfer>
+    static void transfer_read(T* out, const std::size_t n) noexcept {
+        Transfer::read(address, out, n);
+    }
+
+    // The FIFO accesses bypass the shadow value.
+    static_assert(!Register::shadow::value,
+                  "FifoRegister:: shadow value registers are not supported");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_FIFOREGISTER_H
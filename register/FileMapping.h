@@ -0,0 +1,84 @@
+//! File mapping implementation.
+/**
+ * @file      FileMapping.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides mapping types for the mapped memory backend (see
+ * MappedMemory.h) based on device files (e.g., /dev/mem or a UIO device).
+ * It depends on POSIX headers and is therefore not included by cppreg.h;
+ * it has to be included explicitly.
+ */
+
+
+#ifndef CPPREG_FILEMAPPING_H
+#define CPPREG_FILEMAPPING_H
+
+
+#include "cppreg_Defines.h"
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+namespace cppreg {
+
+
+#if defined(__linux__)
+
+//! File mapping implementation (Linux).
+/**
+ * @tparam File File type.
+ *
+ * The file type is required to provide a static function
+ * `const char* path()` and a constant `file_address` which is the address
+ * corresponding to the file offset zero. For example:
+ * - for /dev/mem the file address is zero,
+ * - for a UIO device (/dev/uioX, first memory map) the file address is the
+ *   address of the UIO memory region.
+ */
+template <typename File>
+struct file_mapping {    // NOLINT
+
+    //! Mapping function.
+    /**
+     * @param address Address of the region to be mapped.
+     * @param length Length in bytes of the region to be mapped.
+     * @return A pointer to the mapped region (nullptr on failure).
+     */
+    static void* map(const Address address, const std::size_t length) {
+        const int fd = ::open(File::path(), O_RDWR | O_SYNC);    // NOLINT
+        if (fd < 0) {
+            return nullptr;
+        }
+        void* const region =
+            ::mmap(nullptr,
+                   length,
+                   PROT_READ | PROT_WRITE,    // NOLINT
+                   MAP_SHARED,
+                   fd,
+                   static_cast<off_t>(address - File::file_address));
+        ::close(fd);
+        return (region == MAP_FAILED) ? nullptr : region;    // NOLINT
+    }
+};
+
+
+//! /dev/mem file type.
+struct dev_mem_file {    // NOLINT
+    constexpr static const Address file_address = 0U;
+    static const char* path() noexcept {
+        return "/dev/mem";
+    }
+};
+
+#endif    // __linux__
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_FILEMAPPING_H
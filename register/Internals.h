@@ -49,6 +49,128 @@ struct is_aligned    // NOLINT
           (static_cast<std::size_t>(address) & (alignment - 1)) == 0> {};
 
 
+//! is_same_pack implementation.
+/**
+ * @tparam P First register pack type.
+ * @tparam Q Second register pack type.
+ *
+ * This will only derived from std::true_type if the two register packs
+ * share the same memory region (i.e., same base address and same size).
+ * This makes it possible to compare packs defined by deriving from
+ * RegisterPack.
+ */
+template <typename P, typename Q>
+struct is_same_pack    // NOLINT
+    : std::integral_constant<bool,
+                             (P::pack_base == Q::pack_base)
+                                 && (P::size_in_bytes == Q::size_in_bytes)> {
+};
+
+
+//! Register size in bytes.
+/**
+ * @tparam R Register type.
+ *
+ * This is the number of bytes of the register memory (i.e., the register
+ * width rounded up to bytes), which can be smaller than the register data
+ * type size (see BusRegister).
+ */
+template <typename R>
+struct register_byte_size    // NOLINT
+    : std::integral_constant<std::size_t,
+                             (R::size + one_byte - 1) / one_byte> {};
+
+
+//! is_pack_registers implementation.
+/**
+ * @tparam RegisterPack Register pack type.
+ * @tparam Registers Registers types.
+ *
+ * This will only derived from std::true_type if all the registers belong to
+ * the pack.
+ */
+template <typename RegisterPack, typename... Registers>
+struct is_pack_registers : std::true_type {};    // NOLINT
+template <typename RegisterPack, typename R, typename... Registers>
+struct is_pack_registers<RegisterPack, R, Registers...>    // NOLINT
+    : std::integral_constant<
+          bool,
+          is_same_pack<typename R::pack, RegisterPack>::value
+              && is_pack_registers<RegisterPack, Registers...>::value> {};
+
+
+//! Widest aligned access implementation.
+/**
+ * @tparam address Memory region address.
+ * @tparam n_bytes Memory region size in bytes.
+ * @tparam max_size Maximum access size.
+ *
+ * This defines a value set to the widest access size (not larger than
+ * max_size) such that the memory region can be covered by aligned accesses.
+ */
+template <Address address, std::size_t n_bytes, RegBitSize max_size>
+struct widest_access    // NOLINT
+    : std::conditional<
+          is_aligned<address, TypeTraits<max_size>::byte_size>::value
+              && ((n_bytes % TypeTraits<max_size>::byte_size) == 0),
+          std::integral_constant<RegBitSize, max_size>,
+          widest_access<address,
+                        n_bytes,
+                        static_cast<RegBitSize>(
+                            static_cast<std::uint8_t>(max_size) - 1U)>>::type {
+};
+template <Address address, std::size_t n_bytes>
+struct widest_access<address, n_bytes, RegBitSize::b8>
+    : std::integral_constant<RegBitSize, RegBitSize::b8> {};
+
+
+//! Bit-band region check.
+/**
+ * @param address Address to be checked.
+ * @return `true` if the address is in a bit-band region.
+ *
+ * The bit-band regions are the ones defined for Cortex-M3 and Cortex-M4
+ * cores: the first megabyte of the SRAM region (0x20000000) and the first
+ * megabyte of the peripheral region (0x40000000).
+ */
+constexpr bool is_bit_band_address(const Address address) noexcept {
+    return ((address >= Address{0x20000000}) && (address < Address{0x20100000}))
+           || ((address >= Address{0x40000000})
+               && (address < Address{0x40100000}));
+}
+
+
+//! Bit-band alias address.
+/**
+ * @param address Address of the register (in a bit-band region).
+ * @param bit Bit offset with respect to the register address.
+ * @return The address of the bit-band alias word for the bit.
+ *
+ * Each bit of a bit-band region is mapped to a 32-bit word in the
+ * corresponding alias region (located 32MB after the region base).
+ */
+constexpr Address bit_band_alias(const Address address,
+                                 const FieldOffset bit) noexcept {
+    return (address & Address{0xF0000000}) + Address{0x02000000}
+           + ((address & Address{0x000FFFFF}) << 5U) + (Address{bit} << 2U);
+}
+
+
+//! Bit index from single bit mask.
+/**
+ * @tparam T Mask data type.
+ * @param mask Single bit mask.
+ * @param index Starting index (used for the recursion).
+ * @return The index of the bit set in the mask.
+ */
+template <typename T>
+constexpr FieldOffset bit_index(const T mask,
+                                const FieldOffset index = 0) noexcept {
+    return ((mask >> index) & T{1}) != T{0}
+               ? index
+               : bit_index<T>(mask, static_cast<FieldOffset>(index + 1U));
+}
+
 }    // namespace internals
 }    // namespace cppreg
 
@@ -0,0 +1,154 @@
+//! Mapped memory device implementation.
+/**
+ * @file      MappedMemory.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides a memory device for registers accessed through a
+ * memory mapping established at runtime (e.g., from Linux userspace using
+ * /dev/mem or a UIO device). The mapping is established once per pack, and
+ * the register accesses are then performed relative to the mapping base
+ * pointer using constant offsets. The mapping implementations for device
+ * files (which depend on POSIX headers) are provided in FileMapping.h.
+ */
+
+
+#ifndef CPPREG_MAPPEDMEMORY_H
+#define CPPREG_MAPPEDMEMORY_H
+
+
+#include "Internals.h"
+#include "Traits.h"
+
+#include <cstdlib>
+
+
+namespace cppreg {
+
+
+//! Mapped memory device.
+/**
+ * @tparam Mapping Mapping type.
+ * @tparam mem_address Address of the memory device.
+ * @tparam mem_byte_size Memory device size in bytes.
+ * @tparam granularity Mapping granularity in bytes (power of two).
+ *
+ * The mapping type is required to provide a static function
+ * `void* map(Address address, std::size_t length)` returning a pointer to
+ * the mapped memory region starting at address (or nullptr on failure); the
+ * address and length are multiple of the granularity.
+ *
+ * The mapping is established lazily by the first register access, or
+ * explicitly with map(), which should be used at initialization to check for
+ * errors and before any concurrent use of the pack. If the mapping fails
+ * when accessing a register the program is terminated with std::abort (the
+ * mapping is not attempted again on the next access).
+ */
+template <typename Mapping,
+          Address mem_address,
+          std::size_t mem_byte_size,
+          std::size_t granularity>
+struct MappedMemoryDevice {
+
+    //! Memory device address.
+    constexpr static const Address base_address = mem_address;
+
+    //! Mapping start address.
+    constexpr static const Address map_address =
+        mem_address & ~static_cast<Address>(granularity - 1);
+
+    //! Mapping length in bytes.
+    constexpr static const std::size_t map_length =
+        ((mem_address + mem_byte_size - map_address + granularity - 1)
+         / granularity)
+        * granularity;
+
+    //! Memory device base pointer (nullptr if not mapped).
+    static volatile std::uint8_t* _mem_base;    // NOLINT
+
+    //! Mapping method.
+    /**
+     * @return `true` if the memory device is mapped, `false` otherwise.
+     */
+    static bool map() noexcept {
+        if (_mem_base == nullptr) {
+            auto* const region = static_cast<volatile std::uint8_t*>(
+                Mapping::map(map_address, map_length));
+            if (region != nullptr) {
+                _mem_base = region + (mem_address - map_address);
+            }
+        }
+        return _mem_base != nullptr;
+    }
+
+    //! Accessor.
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static const volatile typename TypeTraits<reg_size>::type& ro_memory() {
+
+        // Check alignment.
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MappedMemoryDevice:: ro request not aligned");
+
+        return *(reinterpret_cast<const volatile    // NOLINT
+                                  typename TypeTraits<reg_size>::type*>(
+            mapped_base() + byte_offset));
+    }
+
+    //! Modifier.
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static volatile typename TypeTraits<reg_size>::type& rw_memory() {
+
+        // Check alignment.
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MappedMemoryDevice:: rw request not aligned");
+
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
+                mapped_base() + byte_offset));
+    }
+
+private:
+    // Mapped base pointer (the mapping is established if needed).
+    static volatile std::uint8_t* mapped_base() noexcept {
+        if ((_mem_base == nullptr) && !map()) {
+            std::abort();
+        }
+        return _mem_base;
+    }
+
+    // The granularity has to be a power of two.
+    static_assert((granularity != 0U)
+                      && ((granularity & (granularity - 1U)) == 0U),
+                  "MappedMemoryDevice:: granularity is not a power of two");
+};
+
+//! Base pointer definition.
+template <typename M, Address a, std::size_t s, std::size_t g>
+volatile std::uint8_t* MappedMemoryDevice<M, a, s, g>::_mem_base = nullptr;
+
+
+//! Mapped memory backend.
+/**
+ * @tparam Mapping Mapping type (see MappedMemoryDevice).
+ * @tparam granularity Mapping granularity in bytes (e.g., the page size).
+ */
+template <typename Mapping, std::size_t granularity = 4096U>
+struct mapped_memory {    // NOLINT
+
+    //! Memory device type.
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        MappedMemoryDevice<Mapping, mem_address, mem_byte_size, granularity>;
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_MAPPEDMEMORY_H
@@ -25,16 +25,20 @@ namespace cppreg {
  * @tparam Mask Mask data type (will be derived from register).
  * @param width Mask width.
  * @return The mask value.
+ *
+ * The mask is obtained by shifting the all ones value of the mask data type
+ * (closed form, no recursion). Widths larger than the number of bits of the
+ * mask data type produce an all ones mask.
  */
 template <typename Mask>
 constexpr Mask make_mask(const FieldWidth width) noexcept {
-    return width == 0U
+    return (width == 0U)
                ? static_cast<Mask>(0U)
                : static_cast<Mask>(
-                   static_cast<Mask>(make_mask<Mask>(FieldWidth(
-                                         static_cast<FieldWidth>(width - 1U)))
-                                     << 1U)
-                   | 1U);
+                   static_cast<Mask>(~static_cast<Mask>(0U))
+                   >> ((width >= std::numeric_limits<Mask>::digits)
+                           ? 0U
+                           : (std::numeric_limits<Mask>::digits - width)));
 }
 
 
@@ -44,14 +48,63 @@ constexpr Mask make_mask(const FieldWidth width) noexcept {
  * @param width Mask width.
  * @param offset Mask offset.
  * @return The mask value.
+ *
+ * Offsets larger than or equal to the number of bits of the mask data type
+ * produce an empty mask.
  */
 template <typename Mask>
 constexpr Mask make_shifted_mask(const FieldWidth width,
                                  const FieldOffset offset) noexcept {
-    return static_cast<Mask>(make_mask<Mask>(width) << offset);
+    return (offset >= std::numeric_limits<Mask>::digits)
+               ? static_cast<Mask>(0U)
+               : static_cast<Mask>(make_mask<Mask>(width) << offset);
 }
 
 
+// Compile-time checks for all register data types (including empty and
+// full-width masks, for which shifts are the most likely to overflow).
+static_assert(make_mask<std::uint8_t>(0U) == 0x0U, "make_mask:: b8/0");
+static_assert(make_mask<std::uint8_t>(1U) == 0x1U, "make_mask:: b8/1");
+static_assert(make_mask<std::uint8_t>(7U) == 0x7FU, "make_mask:: b8/7");
+static_assert(make_mask<std::uint8_t>(8U) == 0xFFU, "make_mask:: b8/8");
+static_assert(make_mask<std::uint16_t>(0U) == 0x0U, "make_mask:: b16/0");
+static_assert(make_mask<std::uint16_t>(1U) == 0x1U, "make_mask:: b16/1");
+static_assert(make_mask<std::uint16_t>(15U) == 0x7FFFU, "make_mask:: b16/15");
+static_assert(make_mask<std::uint16_t>(16U) == 0xFFFFU, "make_mask:: b16/16");
+static_assert(make_mask<std::uint32_t>(0U) == 0x0U, "make_mask:: b32/0");
+static_assert(make_mask<std::uint32_t>(1U) == 0x1U, "make_mask:: b32/1");
+static_assert(make_mask<std::uint32_t>(31U) == 0x7FFFFFFFU,
+              "make_mask:: b32/31");
+static_assert(make_mask<std::uint32_t>(32U) == 0xFFFFFFFFU,
+              "make_mask:: b32/32");
+static_assert(make_mask<std::uint64_t>(0U) == 0x0U, "make_mask:: b64/0");
+static_assert(make_mask<std::uint64_t>(1U) == 0x1U, "make_mask:: b64/1");
+static_assert(make_mask<std::uint64_t>(33U) == 0x1FFFFFFFFU,
+              "make_mask:: b64/33");
+static_assert(make_mask<std::uint64_t>(63U) == 0x7FFFFFFFFFFFFFFFU,
+              "make_mask:: b64/63");
+static_assert(make_mask<std::uint64_t>(64U) == 0xFFFFFFFFFFFFFFFFU,
+              "make_mask:: b64/64");
+static_assert(make_shifted_mask<std::uint8_t>(1U, 7U) == 0x80U,
+              "make_shifted_mask:: b8/1/7");
+static_assert(make_shifted_mask<std::uint8_t>(4U, 6U) == 0xC0U,
+              "make_shifted_mask:: b8/4/6");
+static_assert(make_shifted_mask<std::uint16_t>(1U, 15U) == 0x8000U,
+              "make_shifted_mask:: b16/1/15");
+static_assert(make_shifted_mask<std::uint32_t>(1U, 31U) == 0x80000000U,
+              "make_shifted_mask:: b32/1/31");
+static_assert(make_shifted_mask<std::uint32_t>(8U, 8U) == 0xFF00U,
+              "make_shifted_mask:: b32/8/8");
+static_assert(make_shifted_mask<std::uint64_t>(1U, 63U)
+                  == 0x8000000000000000U,
+              "make_shifted_mask:: b64/1/63");
+static_assert(make_shifted_mask<std::uint64_t>(64U, 0U)
+                  == 0xFFFFFFFFFFFFFFFFU,
+              "make_shifted_mask:: b64/64/0");
+static_assert(make_shifted_mask<std::uint32_t>(1U, 32U) == 0x0U,
+              "make_shifted_mask:: b32/1/32");
+
+
 }    // namespace cppreg
 
 
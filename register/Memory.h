@@ -11,27 +11,119 @@
 
 
 #include "Internals.h"
+#include "MappedMemory.h"
+#include "SimulatedMemory.h"
+#include "Trace.h"
 #include "Traits.h"
 
-#include <array>
-
 
 namespace cppreg {
 
 
+// Forward declaration.
+template <Address mem_address, std::size_t mem_byte_size>
+struct MemoryDevice;
+
+
+//! Physical memory backend.
+/**
+ * This is the default backend: the register memory is accessed at the
+ * register addresses.
+ */
+struct physical_memory {    // NOLINT
+
+    //! Memory device type.
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device = MemoryDevice<mem_address, mem_byte_size>;    // NOLINT
+};
+
+
+//! Default memory backend.
+/**
+ * If CPPREG_SIMULATED_MEMORY is defined the default backend is the
+ * simulated memory backend (without hooks); this makes it possible to run
+ * code using cppreg on a host without modifying the register definitions.
+ */
+#if defined(CPPREG_SIMULATED_MEMORY)
+using default_memory_backend = simulated_memory<>;    // NOLINT
+#else
+using default_memory_backend = physical_memory;    // NOLINT
+#endif
+
+
+// Forward declaration (see MergeWrite.h).
+template <typename RegisterPack, typename... Entries>
+class PackMergeWrite_tmpl;
+
+// Forward declaration (see PackSnapshot.h).
+template <typename RegisterPack, RegBitSize max_access_size>
+class PackSnapshot;
+
+// Forward declaration (see PackState.h).
+template <typename RegisterPack, typename... Items>
+class PackState;
+
+
 //! Register pack base implementation.
 /**
  * @tparam base_address Pack base address.
  * @tparam pack_byte_size Pack size in bytes.
+ * @tparam Backend Memory backend type.
+ *
+ * The memory backend defines the memory device used to access the pack
+ * registers (see physical_memory and simulated_memory).
  */
-template <Address base_address, std::uint32_t pack_byte_size>
+template <Address base_address,
+          std::uint32_t pack_byte_size,
+          typename Backend = default_memory_backend>
 struct RegisterPack {
 
+    //! Memory backend.
+    using backend = Backend;    // NOLINT
+
     //! Base address.
     constexpr static const Address pack_base = base_address;
 
     //! Pack size in bytes.
     constexpr static const std::uint32_t size_in_bytes = pack_byte_size;
+
+    //! Pack merge write start function for constant value.
+    /**
+     * @tparam F Field on which to perform the first write operation.
+     * @tparam value Value to be written to the field.
+     * @return A pack merge write data structure to chain further writes.
+     */
+    template <typename F,
+              typename F::value_type value,
+              typename T = decltype(PackMergeWrite_tmpl<RegisterPack>::create()
+                                        .template with<F, value>())>
+    static T merge_write() noexcept {
+        return PackMergeWrite_tmpl<RegisterPack>::create()
+            .template with<F, value>();
+    }
+
+    //! Snapshot function.
+    /**
+     * @tparam max_access_size Maximum size of the memory accesses.
+     * @return A snapshot of the pack memory region.
+     */
+    template <RegBitSize max_access_size = RegBitSize::b32,
+              typename T = PackSnapshot<RegisterPack, max_access_size>>
+    static T snapshot() noexcept {
+        return T::capture();
+    }
+
+    //! State save function.
+    /**
+     * @tparam Items Fields or masked registers to be saved (see PackState).
+     * @return A pack state with the saved registers values (see
+     * PackState::restore).
+     */
+    template <typename... Items,
+              typename T = PackState<RegisterPack, Items...>>
+    static T save() noexcept {
+        return T::capture();
+    }
 };
 
 
@@ -39,19 +131,31 @@ struct RegisterPack {
 /**
  * @tparam mem_address Address of the memory device.
  * @tparam mem_byte_size Memory device size in bytes.
+ *
+ * The register memory is accessed by casting the constant register address
+ * (i.e., without intermediate storage object), such that the accesses do
+ * not depend on the optimization level.
  */
 template <Address mem_address, std::size_t mem_byte_size>
 struct MemoryDevice {
 
-    //! Storage type.
-    using MemStorage = std::array<volatile std::uint8_t, mem_byte_size>;
+    //! Memory device address.
+    constexpr static const Address base_address = mem_address;
 
-    //! Memory device storage.
-    static MemStorage& _mem_storage;    // NOLINT
+    //! Register address.
+    /**
+     * @tparam byte_offset Offset in bytes with respect to the device address.
+     * @return The register address (usable in constant expressions).
+     */
+    template <std::size_t byte_offset>
+    constexpr static Address address() noexcept {
+        return mem_address + byte_offset;
+    }
 
     //! Accessor.
     template <RegBitSize reg_size, std::size_t byte_offset>
-    static const volatile typename TypeTraits<reg_size>::type& ro_memory() {
+    static const volatile typename TypeTraits<reg_size>::type&
+    ro_memory() noexcept {
 
         // Check alignment.
         static_assert(
@@ -62,12 +166,12 @@ struct MemoryDevice {
 
         return *(reinterpret_cast<const volatile    // NOLINT
                                   typename TypeTraits<reg_size>::type*>(
-            &_mem_storage[byte_offset]));
+            mem_address + byte_offset));
     }
 
     //! Modifier.
     template <RegBitSize reg_size, std::size_t byte_offset>
-    static volatile typename TypeTraits<reg_size>::type& rw_memory() {
+    static volatile typename TypeTraits<reg_size>::type& rw_memory() noexcept {
 
         // Check alignment.
         static_assert(
@@ -78,27 +182,206 @@ struct MemoryDevice {
 
         return *(    // NOLINTNEXTLINE
             reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
-                &_mem_storage[byte_offset]));
+                mem_address + byte_offset));
     }
 };
 
-//! Static reference definition.
-template <Address a, std::size_t s>    // NOLINTNEXTLINE
-typename MemoryDevice<a, s>::MemStorage& MemoryDevice<a, s>::_mem_storage =
-    // NOLINTNEXTLINE
-    *(reinterpret_cast<typename MemoryDevice<a, s>::MemStorage*>(a));
 
+//! Bit-band memory device.
+/**
+ * @tparam reg_address Address of the register containing the bit.
+ * @tparam bit Bit offset with respect to the register address.
+ *
+ * This maps a single bit of a register located in a bit-band region
+ * (Cortex-M3/M4) to its bit-band alias word: a store to the alias word is
+ * an atomic write to the bit (no read-modify-write) and a load from the
+ * alias word returns the bit value (0 or 1).
+ */
+template <Address reg_address, FieldOffset bit>
+struct BitBandDevice {
+
+    //! Alias word address.
+    constexpr static const Address alias_address =
+        internals::bit_band_alias(reg_address, bit);
+
+    //! Accessor.
+    static const volatile std::uint32_t& ro_memory() {
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<const volatile std::uint32_t*>(alias_address));
+    }
+
+    //! Modifier.
+    static volatile std::uint32_t& rw_memory() {
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile std::uint32_t*>(alias_address));
+    }
 
-//! Register memory device for register pack.
+    // Check that the bit is in a bit-band region.
+    static_assert(internals::is_bit_band_address(reg_address
+                                                 + (bit / one_byte)),
+                  "BitBandDevice:: address is not in a bit-band region");
+};
+
+
+namespace internals {
+
+
+//! Bit-band access policy implementation.
+/**
+ * @tparam reg_address Register address (in a bit-band region).
+ *
+ * This implements the bit-band read-write policy for a register at a known
+ * address: the field operations use the alias word of the field bit (see
+ * BitBandDevice) and the register memory device is not accessed.
+ */
+template <Address reg_address>
+struct bit_band_alias_policy : bit_band_read_write {
+
+    //! Read access.
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static T read(const MMIO&) noexcept {
+        return static_cast<T>(alias<T, mask>::ro_memory());
+    }
+
+    //! Write access.
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO&, const T value) noexcept {
+        alias<T, mask>::rw_memory() = static_cast<std::uint32_t>(value & 1u);
+    }
+
+    //! Write access for constant value.
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = static_cast<std::uint32_t>(value & 1u);
+    }
+
+    //! Set access.
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = 1u;
+    }
+
+    //! Clear access.
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = 0u;
+    }
+
+    //! Toggle access.
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() =
+            alias<T, mask>::ro_memory() ^ std::uint32_t{1};
+    }
+
+private:
+    // Alias word of the field bit.
+    template <typename T, T mask>
+    using alias =    // NOLINT
+        BitBandDevice<reg_address, internals::bit_index<T>(mask)>;
+};
+
+
+//! Register policy implementation.
+/**
+ * @tparam P Field access policy type.
+ * @tparam Register Register type.
+ *
+ * This defines the policy implementing the field operations on the register
+ * memory. The bit-band read-write policy is bound to the register address
+ * (the alias word is then a compile-time constant) when the register uses
+ * the physical memory backend, is accessed directly, and lies in a
+ * bit-band region; it reduces to the read-write policy otherwise.
+ */
+template <typename P, typename Register>
+struct register_policy {
+    using type = P;    // NOLINT
+};
+template <typename Register>
+struct register_policy<bit_band_read_write, Register> {
+    using type =    // NOLINT
+        typename std::conditional<
+            std::is_same<typename Register::pack::backend,
+                         physical_memory>::value
+                && std::is_same<typename Register::MMIO,
+                                volatile typename Register::type>::value
+                && is_bit_band_address(Register::base_address)
+                && is_bit_band_address(Register::base_address
+                                       + (Register::size / one_byte) - 1),
+            bit_band_alias_policy<Register::base_address>,
+            read_write>::type;
+};
+
+
+//! Alias register location check.
 /**
+ * @tparam Register Register type.
+ * @tparam byte_offset Offset in bytes of the alias wrt the register.
  *
- * @tparam pack_address Register pack address.
- * @tparam n_bytes Register pack size in bytes.
+ * With the simulated memory backend (without hooks) the alias registers
+ * are accessed within the pack storage, and they are therefore required to
+ * be located within the pack memory region. There is no constraint for the
+ * other backends.
+ */
+template <typename Register, std::ptrdiff_t byte_offset>
+struct is_alias_in_memory    // NOLINT
+    : std::integral_constant<
+          bool,
+          !std::is_same<typename Register::pack::backend,
+                        simulated_memory<false>>::value
+              || ((static_cast<std::ptrdiff_t>(Register::base_address
+                                               - Register::pack::pack_base)
+                   + byte_offset)
+                      >= 0
+                  && (static_cast<std::ptrdiff_t>(Register::base_address
+                                                  - Register::pack::pack_base)
+                      + byte_offset
+                      + static_cast<std::ptrdiff_t>(Register::size / one_byte))
+                         <= static_cast<std::ptrdiff_t>(
+                             Register::pack::size_in_bytes))> {};
+
+
+//!@{ Alias policy location check (see is_alias_in_memory).
+template <typename Register>
+constexpr bool is_policy_alias_in_memory(const void*) noexcept {
+    return true;
+}
+template <typename Register,
+          std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset>
+constexpr bool is_policy_alias_in_memory(
+    const set_clear_alias<set_offset, clear_offset>*) noexcept {
+    return is_alias_in_memory<Register, set_offset>::value
+           && is_alias_in_memory<Register, clear_offset>::value;
+}
+template <typename Register,
+          std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset,
+          std::ptrdiff_t toggle_offset>
+constexpr bool is_policy_alias_in_memory(
+    const set_clear_toggle_alias<set_offset, clear_offset, toggle_offset>*)
+    noexcept {
+    return is_alias_in_memory<Register, set_offset>::value
+           && is_alias_in_memory<Register, clear_offset>::value
+           && is_alias_in_memory<Register, toggle_offset>::value;
+}
+//!@}
+
+
+}    // namespace internals
+
+
+//! Register memory device for register pack.
+/**
+ * @tparam RegisterPack Register pack type.
+ * @tparam Backend Memory backend type (defaults to the pack backend).
  */
-template <typename RegisterPack>
+template <typename RegisterPack,
+          typename Backend = typename RegisterPack::backend>
 struct RegisterMemoryDevice {
     using mem_device =    // NOLINT
-        MemoryDevice<RegisterPack::pack_base, RegisterPack::size_in_bytes>;
+        typename Backend::template device<RegisterPack::pack_base,
+                                          RegisterPack::size_in_bytes>;
 };
 
 
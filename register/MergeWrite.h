@@ -11,6 +11,11 @@
  *
  * By design the merge write implementation forces the caller to chain and
  * finalize all write operations in a single pass.
+ *
+ * The pack merge write implementation extends the constant merge write to
+ * fields spread over several registers of the same register pack. The
+ * writes are grouped per register at compile time and each register is
+ * written only once.
  */
 
 
@@ -19,6 +24,7 @@
 
 
 #include "AccessPolicy.h"
+#include "Barrier.h"
 #include "Internals.h"
 
 
@@ -31,9 +37,11 @@ namespace cppreg {
  * @tparam mask Initial mask.
  * @tparam offset Initial offset.
  * @tparam value Initial value.
+ * @tparam atomic Boolean flag to perform the write as an atomic update.
  *
  * The initial data will come from the field on which the merge write
- * will be initiated.
+ * will be initiated. The write is performed as an atomic update if any of
+ * the merged fields uses an atomic access policy.
  *
  * This implementation is designed for operations in which all data is
  * available at compile time. This makes it possible to leverage a
@@ -44,7 +52,8 @@ namespace cppreg {
 template <typename Register,
           typename Register::type mask,
           FieldOffset offset,
-          typename Register::type value>
+          typename Register::type value,
+          bool atomic = false>
 class MergeWrite_tmpl {    // NOLINT
 
 private:
@@ -58,6 +67,12 @@ private:
     // Combined mask.
     constexpr static auto _combined_mask = mask;    // NOLINT
 
+    // Register value after the write if the register holds its reset value.
+    constexpr static auto _from_reset_value =    // NOLINT
+        static_cast<base_type>(
+            (Register::reset & static_cast<base_type>(~_combined_mask))
+            | _accumulated_value);
+
     // Type helper.
     template <typename F, base_type new_value>
     using propagated =    // NOLINT
@@ -66,14 +81,55 @@ private:
                         FieldOffset{0},
                         (_accumulated_value
                          & static_cast<typename Register::type>(~F::mask))
-                            | ((new_value << F::offset) & F::mask)>;
+                            | ((new_value << F::offset) & F::mask),
+                        atomic || is_atomic_policy<typename F::policy>::value>;
+
+    // Write implementation.
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWriteConstant<typename Register::MMIO,
+                                        base_type,
+                                        _combined_mask,
+                                        FieldOffset{0},
+                                        _accumulated_value>,
+            RegisterWriteConstant<typename Register::MMIO,
+                                  base_type,
+                                  _combined_mask,
+                                  FieldOffset{0},
+                                  _accumulated_value>>::type;
 
     // Default constructor.
     MergeWrite_tmpl() = default;
 
-    // Disabled for shadow value register.
-    static_assert(!Register::shadow::value,
-                  "merge write is not available for shadow value register");
+    // All instances need access to the default constructor.
+    template <typename R,
+              typename R::type m,
+              FieldOffset o,
+              typename R::type v,
+              bool a>
+    friend class MergeWrite_tmpl;
+
+    //!@{ Helpers for closure method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
+
+    // Store of the value computed from the reset value (if different).
+    static void store_from_reset() noexcept {
+        if (_from_reset_value != Register::reset) {
+            RegisterWriteConstant<typename Register::MMIO,
+                                  base_type,
+                                  type_mask<base_type>::value,
+                                  FieldOffset{0},
+                                  _from_reset_value>::
+                write(Register::rw_mem_device());
+        }
+    }
 
 public:
     //! Instantiation method.
@@ -94,11 +150,14 @@ public:
     MergeWrite_tmpl operator=(MergeWrite_tmpl) = delete;
     //!@}
 
-    //! Closure method.
+    //! Closure method (no shadow value).
     /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
      * This is where the write happens.
      */
-    void done() const&& noexcept {
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_no_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
 
         // Get memory pointer.
         typename Register::MMIO& mmio_device = Register::rw_mem_device();
@@ -106,11 +165,64 @@ public:
         // Write to the whole register using the current accumulated value
         // and combined mask.
         // No offset needed because we write to the whole register.
-        RegisterWriteConstant<typename Register::MMIO,
-                              typename Register::type,
+        writer::write(mmio_device);
+        Ordering::apply();
+    }
+
+    //! Closure method (w/ shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
+     * The accumulated value is merged into the shadow value which is then
+     * written as a block to the register (single store).
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
+
+        // Update shadow value.
+        RegisterWriteConstant<base_type,
+                              base_type,
                               _combined_mask,
                               FieldOffset{0},
-                              _accumulated_value>::write(mmio_device);
+                              _accumulated_value>::
+            write(Register::shadow::shadow_value);
+
+        // Write as a block to the register.
+        RegisterWrite<typename Register::MMIO,
+                      base_type,
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+        Ordering::apply();
+    }
+
+    //! Closure method from reset value (no shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
+     * This assumes that the register holds its reset value: the register
+     * value is computed at compile time from the reset value and written
+     * with a single store (no read). Nothing is written if the value is
+     * equal to the reset value.
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void done_from_reset(if_no_shadow<T>* = nullptr) const&& noexcept {
+        store_from_reset();
+        Ordering::apply();
+    }
+
+    //! Closure method from reset value (w/ shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
+     * The shadow value is set to the value computed from the reset value,
+     * which is then written to the register (see above).
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void done_from_reset(if_shadow<T>* = nullptr) const&& noexcept {
+        Register::shadow::shadow_value = _from_reset_value;
+        store_from_reset();
+        Ordering::apply();
     }
 
     //! With method for constant value.
@@ -119,23 +231,31 @@ public:
      * @tparam new_value Value to write to the field.
      * @return A merge write instance with accumulated data.
      */
-    template <typename F, base_type field_value>
-    propagated<F, field_value> with() const&& noexcept {
+    template <typename F, typename F::value_type field_value>
+    propagated<F, static_cast<base_type>(field_value)> with() const&& noexcept {
 
         // Check that the field belongs to the register.
         static_assert(
             std::is_same<typename F::parent_register, Register>::value,
             "MergeWrite_tmpl:: field is not from the same register");
 
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "MergeWrite_tmpl:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "MergeWrite_tmpl:: field is not writable");
+
         // Check that there is no overflow.
         constexpr auto no_overflow =
             internals::check_overflow<typename Register::type,
-                                      field_value,
+                                      static_cast<base_type>(field_value),
                                       (F::mask >> F::offset)>::value;
         static_assert(no_overflow,
                       "MergeWrite_tmpl:: field overflow in with() call");
 
-        return propagated<F, field_value>{};
+        return propagated<F, static_cast<base_type>(field_value)>{};
     }
 };
 
@@ -144,11 +264,13 @@ public:
 /**
  * @tparam Register Register on which the merged write will be performed.
  * @tparam mask Initial mask.
+ * @tparam atomic Boolean flag to perform the write as an atomic update.
  *
  * The initial mask will come from the field on which the merge write
- * will be initiated.
+ * will be initiated. The write is performed as an atomic update if any of
+ * the merged fields uses an atomic access policy.
  */
-template <typename Register, typename Register::type mask>
+template <typename Register, typename Register::type mask, bool atomic = false>
 class MergeWrite {
 
 private:
@@ -164,15 +286,35 @@ private:
     // Type helper.
     template <typename F>
     using propagated =    // NOLINT
-        MergeWrite<Register, _combined_mask | F::mask>;
+        MergeWrite<Register,
+                   _combined_mask | F::mask,
+                   atomic || is_atomic_policy<typename F::policy>::value>;
+
+    // Write implementation.
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWrite<typename Register::MMIO,
+                                base_type,
+                                _combined_mask,
+                                FieldOffset{0}>,
+            RegisterWrite<typename Register::MMIO,
+                          base_type,
+                          _combined_mask,
+                          FieldOffset{0}>>::type;
 
     // Private default constructor.
     constexpr MergeWrite() : _accumulated_value{0} {};
     constexpr explicit MergeWrite(const base_type v) : _accumulated_value{v} {};
 
-    // Disabled for shadow value register.
-    static_assert(!Register::shadow::value,
-                  "merge write is not available for shadow value register");
+    //!@{ Helpers for closure method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
 
 public:
     //! Static instantiation method.
@@ -193,11 +335,14 @@ public:
     MergeWrite& operator=(MergeWrite&&) = delete;
     //!@}
 
-    //! Closure method.
+    //! Closure method (no shadow value).
     /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
      * This is where the write happens.
      */
-    void done() const&& noexcept {
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_no_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
 
         // Get memory pointer.
         typename Register::MMIO& mmio_device = Register::rw_mem_device();
@@ -205,10 +350,31 @@ public:
         // Write to the whole register using the current accumulated value
         // and combined mask.
         // No offset needed because we write to the whole register.
+        writer::write(mmio_device, _accumulated_value);
+        Ordering::apply();
+    }
+
+    //! Closure method (w/ shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the write.
+     *
+     * The accumulated value is merged into the shadow value which is then
+     * written as a block to the register (single store).
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
+
+        // Update shadow value.
+        RegisterWrite<base_type, base_type, _combined_mask, FieldOffset{0}>::
+            write(Register::shadow::shadow_value, _accumulated_value);
+
+        // Write as a block to the register.
         RegisterWrite<typename Register::MMIO,
                       base_type,
-                      _combined_mask,
-                      FieldOffset{0}>::write(mmio_device, _accumulated_value);
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+        Ordering::apply();
     }
 
     //! With method.
@@ -218,16 +384,25 @@ public:
      * @return A merge write instance with accumulated data.
      */
     template <typename F>
-    propagated<F> with(const base_type value) const&& noexcept {
+    propagated<F> with(const typename F::value_type value) const&& noexcept {
 
         // Check that the field belongs to the register.
         static_assert(
             std::is_same<typename F::parent_register, Register>::value,
             "field is not from the same register in merge_write");
 
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "MergeWrite:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "MergeWrite:: field is not writable");
+
         // Update accumulated value.
         constexpr auto neg_mask = static_cast<base_type>(~F::mask);
-        const auto shifted_value = static_cast<base_type>(value << F::offset);
+        const auto shifted_value =
+            static_cast<base_type>(static_cast<base_type>(value) << F::offset);
         const auto lhs = static_cast<base_type>(_accumulated_value & neg_mask);
         const auto rhs = static_cast<base_type>(shifted_value & F::mask);
         return propagated<F>::create(static_cast<base_type>(lhs | rhs));
@@ -235,6 +410,370 @@ public:
 };
 
 
+namespace internals {
+
+
+//! Pack merge write entry.
+/**
+ * @tparam Register Register to be written.
+ * @tparam mask Combined mask of the fields written in the register.
+ * @tparam value Accumulated value (already shifted and masked).
+ * @tparam atomic Boolean flag to perform the write as an atomic update.
+ *
+ * This holds all the writes performed on a given register as part of a
+ * pack merge write. The write is performed as an atomic update if any of
+ * the fields written in the register uses an atomic access policy.
+ */
+template <typename Register,
+          typename Register::type mask,
+          typename Register::type value,
+          bool atomic = false>
+struct pack_write_entry {    // NOLINT
+
+    //! Register type.
+    using reg = Register;    // NOLINT
+
+    //! Combined mask.
+    constexpr static auto combined_mask = mask;
+
+    //! Accumulated value.
+    constexpr static auto accumulated_value = value;
+
+    //! Register value after the write if the register holds its reset value.
+    constexpr static auto from_reset_value = static_cast<
+        typename Register::type>(
+        (Register::reset & static_cast<typename Register::type>(~mask))
+        | value);
+
+    //! Atomic update flag.
+    constexpr static auto is_atomic = atomic;
+
+    //! Write implementation.
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWriteConstant<typename Register::MMIO,
+                                        typename Register::type,
+                                        mask,
+                                        FieldOffset{0},
+                                        value>,
+            RegisterWriteConstant<typename Register::MMIO,
+                                  typename Register::type,
+                                  mask,
+                                  FieldOffset{0},
+                                  value>>::type;
+
+    //!@{ Helpers for write method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
+
+    //! Write method (no shadow value).
+    /**
+     * If the combined mask covers the whole register this is a single
+     * store, otherwise this is a read-modify-write (or an atomic update).
+     */
+    template <typename T = void>
+    static void write(if_no_shadow<T>* = nullptr) noexcept {    // NOLINT
+        writer::write(Register::rw_mem_device());
+    }
+
+    //! Write method (w/ shadow value).
+    /**
+     * The accumulated value is merged into the shadow value which is then
+     * written as a block to the register (single store).
+     */
+    template <typename T = void>
+    static void write(if_shadow<T>* = nullptr) noexcept {    // NOLINT
+        using base_type = typename Register::type;
+        RegisterWriteConstant<base_type,
+                              base_type,
+                              combined_mask,
+                              FieldOffset{0},
+                              accumulated_value>::
+            write(Register::shadow::shadow_value);
+        RegisterWrite<typename Register::MMIO,
+                      base_type,
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+    }
+
+    //! Write method from reset value (no shadow value).
+    /**
+     * This assumes that the register holds its reset value: the value
+     * computed from the reset value is written with a single store (no
+     * read), or not written at all if equal to the reset value.
+     */
+    template <typename T = void>
+    static void write_from_reset(if_no_shadow<T>* = nullptr) noexcept {
+        store_from_reset();
+    }
+
+    //! Write method from reset value (w/ shadow value).
+    /**
+     * The shadow value is set to the value computed from the reset value,
+     * which is then written to the register (see above).
+     */
+    template <typename T = void>
+    static void write_from_reset(if_shadow<T>* = nullptr) noexcept {
+        Register::shadow::shadow_value = from_reset_value;
+        store_from_reset();
+    }
+
+    // Store of the value computed from the reset value (if different).
+    static void store_from_reset() noexcept {
+        if (from_reset_value != Register::reset) {
+            RegisterWriteConstant<typename Register::MMIO,
+                                  typename Register::type,
+                                  type_mask<typename Register::type>::value,
+                                  FieldOffset{0},
+                                  from_reset_value>::
+                write(Register::rw_mem_device());
+        }
+    }
+};
+
+
+//! Field write used to update a pack merge write.
+/**
+ * @tparam F Field to be written.
+ * @tparam value Value to be written to the field.
+ */
+template <typename F, typename F::type value>
+struct pack_write_field {    // NOLINT
+
+    //! Register type.
+    using reg = typename F::parent_register;    // NOLINT
+
+    //! Entry for a register without previous writes.
+    using entry =    // NOLINT
+        pack_write_entry<reg,
+                         F::mask,
+                         static_cast<typename F::type>((value << F::offset)
+                                                       & F::mask),
+                         is_atomic_policy<typename F::policy>::value>;
+
+    //! Entry merged with previous writes to the same register.
+    /**
+     * @tparam E Entry holding the previous writes.
+     */
+    template <typename E>
+    using merged =    // NOLINT
+        pack_write_entry<reg,
+                         static_cast<typename F::type>(E::combined_mask
+                                                       | F::mask),
+                         static_cast<typename F::type>(
+                             (E::accumulated_value
+                              & static_cast<typename F::type>(~F::mask))
+                             | entry::accumulated_value),
+                         E::is_atomic || entry::is_atomic>;
+};
+
+
+//! List of pack merge write entries.
+template <typename... Entries>
+struct pack_write_list {};    // NOLINT
+
+
+//! Prepend an entry to a list of entries.
+template <typename Entry, typename List>
+struct pack_write_prepend;    // NOLINT
+template <typename Entry, typename... Entries>
+struct pack_write_prepend<Entry, pack_write_list<Entries...>> {
+    using type = pack_write_list<Entry, Entries...>;    // NOLINT
+};
+
+
+//! Insert a field write into a list of entries.
+/**
+ * @tparam List List of entries (sorted by ascending register address).
+ * @tparam W Field write to be inserted.
+ *
+ * If the list already contains an entry for the field register the write is
+ * merged into it, otherwise a new entry is inserted such that the list
+ * remains sorted by ascending register address.
+ */
+template <typename List, typename W>
+struct pack_write_insert;    // NOLINT
+
+//! Insertion in an empty list.
+template <typename W>
+struct pack_write_insert<pack_write_list<>, W> {
+    using type = pack_write_list<typename W::entry>;    // NOLINT
+};
+
+//! Insertion implementation.
+/**
+ * @tparam List List of entries.
+ * @tparam W Field write to be inserted.
+ * @tparam order Position of the write wrt the list head (-1: before, 0: same
+ *               register, 1: after).
+ */
+template <typename List, typename W, int order>
+struct pack_write_insert_impl;    // NOLINT
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, -1> {
+    using type = pack_write_list<typename W::entry, Head, Tail...>;    // NOLINT
+};
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, 0> {
+    using type =    // NOLINT
+        pack_write_list<typename W::template merged<Head>, Tail...>;
+};
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, 1> {
+    using type = typename pack_write_prepend<    // NOLINT
+        Head,
+        typename pack_write_insert<pack_write_list<Tail...>, W>::type>::type;
+};
+
+//! Insertion in a non-empty list.
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert<pack_write_list<Head, Tail...>, W>
+    : pack_write_insert_impl<
+          pack_write_list<Head, Tail...>,
+          W,
+          std::is_same<typename Head::reg, typename W::reg>::value
+              ? 0
+              : (W::reg::base_address < Head::reg::base_address ? -1 : 1)> {
+};
+
+
+}    // namespace internals
+
+
+//! Pack merge write constant implementation.
+/**
+ * @tparam RegisterPack Pack on which the merged write will be performed.
+ * @tparam Entries Pack merge write entries (one per register).
+ *
+ * This implementation is the pack counterpart of MergeWrite_tmpl: it makes
+ * it possible to chain constant writes to fields of different registers
+ * from the same pack. The writes are accumulated at compile time in one
+ * entry per register, and when closing the merge write each register is
+ * written once, in ascending address order. For registers whose fields are
+ * all written the write is a single store, and for registers with atomic
+ * fields the write is an atomic update. For shadow value registers the
+ * shadow value is updated and written as a block.
+ */
+template <typename RegisterPack, typename... Entries>
+class PackMergeWrite_tmpl {    // NOLINT
+
+private:
+    // Type helper.
+    template <typename List>
+    struct rebind;    // NOLINT
+    template <typename... E>
+    struct rebind<internals::pack_write_list<E...>> {
+        using type = PackMergeWrite_tmpl<RegisterPack, E...>;    // NOLINT
+    };
+
+    // Type helper.
+    template <typename F, typename F::type new_value>
+    using propagated =    // NOLINT
+        typename rebind<typename internals::pack_write_insert<
+            internals::pack_write_list<Entries...>,
+            internals::pack_write_field<F, new_value>>::type>::type;
+
+    // Default constructor.
+    PackMergeWrite_tmpl() = default;
+
+    // All instances need access to the default constructor.
+    template <typename P, typename... E>
+    friend class PackMergeWrite_tmpl;
+
+public:
+    //! Instantiation method.
+    static PackMergeWrite_tmpl create() noexcept {
+        return {};
+    }
+
+    //! Destructor.
+    ~PackMergeWrite_tmpl() = default;
+
+    //! Move constructor.
+    PackMergeWrite_tmpl(PackMergeWrite_tmpl&&) noexcept = default;
+
+    //!@{ Non-copyable and non-assignable.
+    PackMergeWrite_tmpl(const PackMergeWrite_tmpl&) = delete;
+    PackMergeWrite_tmpl& operator=(const PackMergeWrite_tmpl&) = delete;
+    PackMergeWrite_tmpl& operator=(PackMergeWrite_tmpl&&) = delete;
+    //!@}
+
+    //! Closure method.
+    /**
+     * @tparam Ordering Ordering policy applied after the writes.
+     *
+     * This is where the writes happen (one per register, in ascending
+     * address order).
+     */
+    template <typename Ordering = no_barrier>
+    void done() const&& noexcept {
+        // The initializer list guarantees the evaluation order.
+        const int expand[] = {0, (Entries::write(), 0)...};
+        static_cast<void>(expand);
+        Ordering::apply();
+    }
+
+    //! Closure method from reset values.
+    /**
+     * @tparam Ordering Ordering policy applied after the writes.
+     *
+     * This assumes that the registers hold their reset values: each
+     * register value is computed at compile time from its reset value and
+     * written with a single store (no read); registers whose value is equal
+     * to the reset value are not written.
+     */
+    template <typename Ordering = no_barrier>
+    void done_from_reset() const&& noexcept {
+        const int expand[] = {0, (Entries::write_from_reset(), 0)...};
+        static_cast<void>(expand);
+        Ordering::apply();
+    }
+
+    //! With method for constant value.
+    /**
+     * @tparam F Field to be written.
+     * @tparam field_value Value to write to the field.
+     * @return A pack merge write instance with accumulated data.
+     */
+    template <typename F, typename F::value_type field_value>
+    propagated<F, static_cast<typename F::type>(field_value)> with() const&&
+        noexcept {
+
+        // Check that the field belongs to the pack.
+        static_assert(
+            internals::is_same_pack<typename F::parent_register::pack,
+                                    RegisterPack>::value,
+            "PackMergeWrite_tmpl:: field is not from the same pack");
+
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "PackMergeWrite_tmpl:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "PackMergeWrite_tmpl:: field is not writable");
+
+        // Check that there is no overflow.
+        constexpr auto no_overflow =
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(
+                                          field_value),
+                                      (F::mask >> F::offset)>::value;
+        static_assert(no_overflow,
+                      "PackMergeWrite_tmpl:: field overflow in with() call");
+
+        return propagated<F, static_cast<typename F::type>(field_value)>{};
+    }
+};
+
+
 }    // namespace cppreg
 
 
@@ -0,0 +1,528 @@
+//! Register pack image implementation.
+/**
+ * @file      PackImage.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides a model of the content of a register pack which can
+ * be used in constant expressions: the field operations are performed on
+ * the image instead of the register memory. A configuration sequence can
+ * then be evaluated at compile time (e.g., to check it with static_assert)
+ * and the resulting image stored to the registers at runtime.
+ *
+ * The same sequence can be written once for both the image and the register
+ * memory by taking the device as a template parameter: PackImage for the
+ * model and PackAccess for the register memory provide the same methods.
+ *
+ * The image requires C++14 (relaxed constexpr).
+ */
+
+
+#ifndef CPPREG_PACKIMAGE_H
+#define CPPREG_PACKIMAGE_H
+
+
+#include "AccessPolicy.h"
+#include "Internals.h"
+#include "Memory.h"
+#include "RegisterValue.h"
+
+
+namespace cppreg {
+
+
+#if __cplusplus >= 201402L
+
+
+namespace internals {
+
+
+//! Merge write implementation for a device.
+/**
+ * @tparam Device Device type (PackImage).
+ *
+ * The writes are performed on the device as they are chained; this provides
+ * the same interface as the merge write implementations.
+ */
+template <typename Device>
+class device_merge_write {    // NOLINT
+
+private:
+    // Device on which the writes are performed.
+    Device& _device;    // NOLINT
+
+public:
+    //! Constructor.
+    /**
+     * @param device Device on which the writes are performed.
+     */
+    constexpr explicit device_merge_write(Device& device) noexcept
+        : _device{device} {};
+
+    //! With method.
+    /**
+     * @tparam F Field type.
+     * @param value Value to write to the field.
+     * @return The merge write (to chain calls).
+     */
+    template <typename F>
+    constexpr device_merge_write with(
+        const typename F::value_type value) const noexcept {
+        _device.template write<F>(value);
+        return *this;
+    }
+
+    //! With method for constant value.
+    /**
+     * @tparam F Field type.
+     * @tparam value Value to write to the field.
+     * @return The merge write (to chain calls).
+     */
+    template <typename F, typename F::value_type value>
+    constexpr device_merge_write with() const noexcept {
+        _device.template write<F, value>();
+        return *this;
+    }
+
+    //! Closure method.
+    constexpr void done() const noexcept {}
+};
+
+
+}    // namespace internals
+
+
+//! Register pack image implementation.
+/**
+ * @tparam RegisterPack Register pack type.
+ * @tparam max_access_size Maximum size of the memory accesses.
+ *
+ * The image holds the content of the pack memory region as words of the
+ * widest accesses (not larger than max_access_size) for which the pack base
+ * address and size are aligned (see PackSnapshot), in little-endian order.
+ * All the methods but the store methods can be used in constant
+ * expressions. The access policies are not modeled: all the fields can be
+ * read, and the fields which can be written with plain writes (read-write,
+ * write-only or atomic policies, see is_plain_writable_policy) can be
+ * written.
+ */
+template <typename RegisterPack, RegBitSize max_access_size = RegBitSize::b32>
+class PackImage {
+
+public:
+    //! Access size (image words size).
+    constexpr static const auto access_size =
+        internals::widest_access<RegisterPack::pack_base,
+                                 RegisterPack::size_in_bytes,
+                                 max_access_size>::value;
+
+    //! Access data type.
+    using access_type = typename TypeTraits<access_size>::type;    // NOLINT
+
+    //! Number of words in the image.
+    constexpr static const std::size_t n_accesses =
+        RegisterPack::size_in_bytes / TypeTraits<access_size>::byte_size;
+
+    //! Storage type.
+    using storage_type = access_type[n_accesses];    // NOLINT
+
+private:
+    // Memory device.
+    using mem_device =    // NOLINT
+        typename RegisterMemoryDevice<RegisterPack>::mem_device;
+
+    // Word size in bytes.
+    constexpr static const std::size_t word_bytes =
+        TypeTraits<access_size>::byte_size;
+
+    // Image storage.
+    storage_type _storage;    // NOLINT
+
+    // Store implementation (ascending address order).
+    template <std::size_t index, std::size_t end>
+    struct store_words {    // NOLINT
+        static void apply(const storage_type& storage) noexcept {
+            mem_device::template rw_memory<access_size, index * word_bytes>() =
+                storage[index];
+            store_words<index + 1, end>::apply(storage);
+        }
+    };
+    template <std::size_t end>
+    struct store_words<end, end> {    // NOLINT
+        static void apply(const storage_type&) noexcept {}    // NOLINT
+    };
+
+    // Register offset in bytes with respect to the pack base.
+    template <typename R>
+    struct register_offset    // NOLINT
+        : std::integral_constant<
+              std::size_t,
+              static_cast<std::size_t>(R::base_address
+                                       - RegisterPack::pack_base)> {
+
+        // Check that the register belongs to the pack.
+        static_assert(
+            internals::is_same_pack<typename R::pack, RegisterPack>::value,
+            "PackImage:: register is not from the same pack");
+    };
+
+    // Byte accessor.
+    constexpr std::uint8_t get_byte(const std::size_t index) const noexcept {
+        return static_cast<std::uint8_t>(
+            _storage[index / word_bytes]
+            >> (one_byte * (index % word_bytes)));
+    }
+
+    // Byte modifier.
+    constexpr void set_byte(const std::size_t index,
+                            const std::uint8_t value) noexcept {
+        const auto shift = one_byte * (index % word_bytes);
+        access_type& word = _storage[index / word_bytes];
+        word = static_cast<access_type>(
+            (word & static_cast<access_type>(~(access_type{0xFF} << shift)))
+            | static_cast<access_type>(access_type{value} << shift));
+    }
+
+    // Field write implementation.
+    template <typename F>
+    constexpr void update(const typename F::type value) noexcept {
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "PackImage:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "PackImage:: field is not writable");
+        using R = typename F::parent_register;
+        const auto current = register_value<R>();
+        write_register<R>(static_cast<typename R::type>(
+            (current & static_cast<typename R::type>(~F::mask))
+            | (static_cast<typename R::type>(value << F::offset) & F::mask)));
+    }
+
+public:
+    //! Default constructor (zero-initialized content).
+    constexpr PackImage() noexcept : _storage{} {};
+
+    //! Reset image method.
+    /**
+     * @tparam Registers Registers of the pack.
+     * @return An image holding the reset values of the registers (the other
+     * bytes of the pack are zero).
+     */
+    template <typename... Registers>
+    constexpr static PackImage from_reset() noexcept {
+        PackImage image;
+        const int expand[] = {
+            0, (image.template write_register<Registers>(Registers::reset),
+                0)...};
+        static_cast<void>(expand);
+        return image;
+    }
+
+    //! Raw storage accessor.
+    /**
+     * @return A const reference to the image words (e.g., for a DMA
+     * transfer to the pack memory region).
+     */
+    constexpr const storage_type& raw() const noexcept {
+        return _storage;
+    }
+
+    //! Register value accessor.
+    /**
+     * @tparam R Register type (from the pack).
+     * @return The register value in the image.
+     */
+    template <typename R>
+    constexpr typename R::type register_value() const noexcept {
+        auto value = typename R::type{0};
+        for (std::size_t i = 0; i < internals::register_byte_size<R>::value;
+             ++i) {
+            value = static_cast<typename R::type>(
+                value
+                | static_cast<typename R::type>(
+                    static_cast<typename R::type>(
+                        get_byte(register_offset<R>::value + i))
+                    << (one_byte * i)));
+        }
+        return value;
+    }
+
+    //! Register value accessor (decoded).
+    /**
+     * @tparam R Register type (from the pack).
+     * @return The register value in the image (to decode the fields).
+     */
+    template <typename R>
+    constexpr RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
+    }
+
+    //! Register write method.
+    /**
+     * @tparam R Register type (from the pack).
+     * @param value Register value.
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename R>
+    constexpr PackImage& write_register(
+        const typename R::type value) noexcept {
+        for (std::size_t i = 0; i < internals::register_byte_size<R>::value;
+             ++i) {
+            set_byte(register_offset<R>::value + i,
+                     static_cast<std::uint8_t>(value >> (one_byte * i)));
+        }
+        return *this;
+    }
+
+    //! Field read method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return The field value in the image.
+     */
+    template <typename F>
+    constexpr typename F::value_type read() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::value_type>(
+            static_cast<typename F::type>((value & F::mask) >> F::offset));
+    }
+
+    //! Is field set bool method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return `true` if all the bits are set to 1, `false` otherwise.
+     */
+    template <typename F>
+    constexpr bool is_set() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask) == F::mask;
+    }
+
+    //! Is field clear bool method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return `true` if all the bits are set to 0, `false` otherwise.
+     */
+    template <typename F>
+    constexpr bool is_clear() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask)
+               == typename F::type{0};
+    }
+
+    //! Field write method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @param value Value to be written to the field.
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename F>
+    constexpr PackImage& write(const typename F::value_type value) noexcept {
+        update<F>(static_cast<typename F::type>(value));
+        return *this;
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @tparam value Constant to be written to the field.
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename F, typename F::value_type value>
+    constexpr PackImage& write() noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "PackImage::write<value>: value too large for the field");
+
+        return write<F>(value);
+    }
+
+    //! Field set method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename F>
+    constexpr PackImage& set() noexcept {
+        update<F>(F::mask >> F::offset);
+        return *this;
+    }
+
+    //! Field clear method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename F>
+    constexpr PackImage& clear() noexcept {
+        update<F>(typename F::type{0});
+        return *this;
+    }
+
+    //! Field toggle method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return A reference to the image (to chain calls).
+     */
+    template <typename F>
+    constexpr PackImage& toggle() noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        update<F>(static_cast<typename F::type>(
+            (static_cast<typename F::type>(~value) & F::mask) >> F::offset));
+        return *this;
+    }
+
+    //! Merge write start method.
+    /**
+     * @tparam F Field on which to perform the first write operation.
+     * @param value Value to be written to the field.
+     * @return A merge write to chain further writes.
+     */
+    template <typename F>
+    constexpr internals::device_merge_write<PackImage> merge_write(
+        const typename F::value_type value) noexcept {
+        write<F>(value);
+        return internals::device_merge_write<PackImage>{*this};
+    }
+
+    //! Merge write start method for constant value.
+    /**
+     * @tparam F Field on which to perform the first write operation.
+     * @tparam value Value to be written to the field.
+     * @return A merge write to chain further writes.
+     */
+    template <typename F, typename F::value_type value>
+    constexpr internals::device_merge_write<PackImage> merge_write() noexcept {
+        write<F, value>();
+        return internals::device_merge_write<PackImage>{*this};
+    }
+
+    //! Store method.
+    /**
+     * This writes the whole image to the pack memory region (n_accesses
+     * writes, in ascending address order).
+     */
+    void store() const noexcept {
+        store_words<0, n_accesses>::apply(_storage);
+    }
+
+    //! Store method for a list of registers.
+    /**
+     * @tparam Registers Registers of the pack.
+     *
+     * This writes the image value of each register (one write per register,
+     * in the order of the list).
+     */
+    template <typename... Registers>
+    void store() const noexcept {
+        const int expand[] = {
+            0, ((Registers::rw_mem_device() = register_value<Registers>()),
+                0)...};
+        static_cast<void>(expand);
+    }
+};
+
+
+//! Register pack access implementation.
+/**
+ * @tparam RegisterPack Register pack type.
+ *
+ * This provides the device methods of PackImage for the register memory
+ * (i.e., it forwards to the field and register methods), such that the
+ * same sequence can be performed on an image or on the registers.
+ */
+template <typename RegisterPack>
+struct PackAccess {
+
+    //! Register value accessor.
+    template <typename R>
+    typename R::type register_value() const noexcept {
+        return R::read_value().raw();
+    }
+
+    //! Register value accessor (decoded).
+    template <typename R>
+    RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
+    }
+
+    //! Field read method.
+    template <typename F>
+    typename F::value_type read() const noexcept {
+        return F::read();
+    }
+
+    //! Is field set bool method.
+    template <typename F>
+    bool is_set() const noexcept {
+        return F::is_set();
+    }
+
+    //! Is field clear bool method.
+    template <typename F>
+    bool is_clear() const noexcept {
+        return F::is_clear();
+    }
+
+    //! Field write method.
+    template <typename F>
+    PackAccess& write(const typename F::value_type value) noexcept {
+        F::write(value);
+        return *this;
+    }
+
+    //! Field write constant method.
+    template <typename F, typename F::value_type value>
+    PackAccess& write() noexcept {
+        F::template write<value>();
+        return *this;
+    }
+
+    //! Field set method.
+    template <typename F>
+    PackAccess& set() noexcept {
+        F::set();
+        return *this;
+    }
+
+    //! Field clear method.
+    template <typename F>
+    PackAccess& clear() noexcept {
+        F::clear();
+        return *this;
+    }
+
+    //! Field toggle method.
+    template <typename F>
+    PackAccess& toggle() noexcept {
+        F::toggle();
+        return *this;
+    }
+
+    //! Merge write start method.
+    template <typename F>
+    auto merge_write(const typename F::value_type value) noexcept
+        -> decltype(F::parent_register::template merge_write<F>(value)) {
+        return F::parent_register::template merge_write<F>(value);
+    }
+
+    //! Merge write start method for constant value.
+    template <typename F, typename F::value_type value>
+    auto merge_write() noexcept
+        -> decltype(F::parent_register::template merge_write<F, value>()) {
+        return F::parent_register::template merge_write<F, value>();
+    }
+};
+
+
+#endif    // __cplusplus 201402L
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_PACKIMAGE_H
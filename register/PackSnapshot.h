@@ -0,0 +1,255 @@
+//! Register pack snapshot implementation.
+/**
+ * @file      PackSnapshot.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the implementation of register pack snapshots. A
+ * snapshot is a copy of the whole memory region of a register pack which is
+ * obtained using the widest aligned accesses. Fields and registers of the
+ * pack can then be decoded from the snapshot without accessing the register
+ * memory again.
+ *
+ * The whole memory region is read, including registers for which reads have
+ * side effects (e.g., read-to-clear fields or FIFO data registers): a
+ * snapshot should not be used for packs containing such registers, or the
+ * side effects have to be acceptable.
+ */
+
+
+#ifndef CPPREG_PACKSNAPSHOT_H
+#define CPPREG_PACKSNAPSHOT_H
+
+
+#include "Internals.h"
+#include "Mask.h"
+#include "Memory.h"
+#include "RegisterValue.h"
+
+#include <array>
+#include <cstring>
+
+
+namespace cppreg {
+
+
+//! Register pack snapshot implementation.
+/**
+ * @tparam RegisterPack Register pack type.
+ * @tparam max_access_size Maximum size of the memory accesses.
+ *
+ * The snapshot copies the pack memory region using the widest accesses (not
+ * larger than max_access_size) for which the pack base address and size are
+ * aligned. The maximum access size should be set such that the accesses are
+ * legal for the peripheral.
+ *
+ * The snapshot content can also be filled by other means (e.g., by a DMA
+ * transfer) using the raw storage accessor.
+ *
+ * Capturing a snapshot reads all the registers of the pack: read-to-clear
+ * fields are cleared and FIFO data registers are popped (see above).
+ */
+template <typename RegisterPack, RegBitSize max_access_size = RegBitSize::b32>
+class PackSnapshot {
+
+public:
+    //! Access size used for the copy.
+    constexpr static const auto access_size =
+        internals::widest_access<RegisterPack::pack_base,
+                                 RegisterPack::size_in_bytes,
+                                 max_access_size>::value;
+
+    //! Access data type.
+    using access_type = typename TypeTraits<access_size>::type;    // NOLINT
+
+    //! Number of accesses required to copy the pack.
+    constexpr static const std::size_t n_accesses =
+        RegisterPack::size_in_bytes / TypeTraits<access_size>::byte_size;
+
+    //! Storage type.
+    using storage_type = std::array<access_type, n_accesses>;    // NOLINT
+
+private:
+    // Memory device.
+    using mem_device =    // NOLINT
+        typename RegisterMemoryDevice<RegisterPack>::mem_device;
+
+    // Snapshot storage.
+    storage_type _storage;    // NOLINT
+
+    // Copy implementation.
+    template <std::size_t index, std::size_t end>
+    struct copy {    // NOLINT
+        static void apply(storage_type& storage) noexcept {
+            storage[index] = mem_device::template ro_memory<
+                access_size,
+                index * TypeTraits<access_size>::byte_size>();
+            copy<index + 1, end>::apply(storage);
+        }
+    };
+    template <std::size_t end>
+    struct copy<end, end> {    // NOLINT
+        static void apply(storage_type&) noexcept {}    // NOLINT
+    };
+
+    // Register offset in bytes with respect to the pack base.
+    template <typename R>
+    struct register_offset    // NOLINT
+        : std::integral_constant<
+              std::size_t,
+              static_cast<std::size_t>(R::base_address
+                                       - RegisterPack::pack_base)> {
+
+        // Check that the register belongs to the pack.
+        static_assert(
+            internals::is_same_pack<typename R::pack, RegisterPack>::value,
+            "PackSnapshot:: register is not from the same pack");
+    };
+
+    //!@{ Bus register check (see BusRegister).
+    template <typename R>
+    static std::true_type is_bus_register(const typename R::bus*);
+    template <typename R>
+    static std::false_type is_bus_register(...);
+    //!@}
+
+    // Memory access value in the snapshot (native byte order).
+    template <typename T>
+    T load(const std::size_t byte_offset) const noexcept {
+        auto value = T{0};
+        std::memcpy(&value,
+                    reinterpret_cast<const std::uint8_t*>(    // NOLINT
+                        _storage.data())
+                        + byte_offset,
+                    sizeof(T));
+        return value;
+    }
+
+    // Register value (register read with a single access).
+    template <typename R>
+    typename R::type decode(std::false_type) const noexcept {
+        return load<typename R::type>(register_offset<R>::value);
+    }
+
+    // Bus register value.
+    // The register bits are combined from the bus words with shifts, as
+    // for the bus register accesses (see internals::bus_words).
+    template <typename R>
+    typename R::type decode(std::true_type) const noexcept {
+        using type = typename R::type;                                // NOLINT
+        using device = typename R::MMIO;                              // NOLINT
+        using word_type = typename TypeTraits<R::bus::size>::type;    // NOLINT
+        using wide_type =                                             // NOLINT
+            typename std::conditional<(sizeof(type) > sizeof(word_type)),
+                                      type,
+                                      word_type>::type;
+        constexpr auto word_bits = TypeTraits<R::bus::size>::bit_size;
+        auto value = type{0};
+        for (std::size_t i = 0; i < device::n_words; ++i) {
+            const auto word = static_cast<wide_type>(load<word_type>(
+                device::first_offset + (i * device::word_bytes)));
+            value = static_cast<type>(
+                value
+                | static_cast<type>(
+                    (i == 0) ? static_cast<wide_type>(word >> device::shift)
+                             : static_cast<wide_type>(
+                                 word << ((i * word_bits) - device::shift))));
+        }
+        return static_cast<type>(
+            value & make_mask<type>(static_cast<FieldWidth>(R::size)));
+    }
+
+public:
+    //! Default constructor (zero-initialized content).
+    PackSnapshot() : _storage{} {};
+
+    //! Capture method.
+    /**
+     * @return A snapshot of the pack memory region.
+     *
+     * This performs n_accesses reads of the register memory, in ascending
+     * address order.
+     */
+    static PackSnapshot capture() noexcept {
+        PackSnapshot snapshot;
+        copy<0, n_accesses>::apply(snapshot._storage);
+        return snapshot;
+    }
+
+    //! Raw storage accessor.
+    /**
+     * @return A reference to the snapshot storage.
+     */
+    storage_type& raw() noexcept {
+        return _storage;
+    }
+
+    //! Raw storage accessor.
+    /**
+     * @return A const reference to the snapshot storage.
+     */
+    const storage_type& raw() const noexcept {
+        return _storage;
+    }
+
+    //! Register value accessor.
+    /**
+     * @tparam R Register type (from the pack).
+     * @return The register value in the snapshot.
+     */
+    template <typename R>
+    typename R::type register_value() const noexcept {
+        return decode<R>(decltype(is_bus_register<R>(nullptr)){});
+    }
+
+    //! Register value accessor (decoded).
+    /**
+     * @tparam R Register type (from the pack).
+     * @return The register value in the snapshot (see RegisterValue).
+     */
+    template <typename R>
+    RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
+    }
+
+    //! Field read method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return The field value in the snapshot.
+     */
+    template <typename F>
+    typename F::value_type read() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::value_type>(
+            static_cast<typename F::type>((value & F::mask) >> F::offset));
+    }
+
+    //! Is field set bool method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return `true` if all the bits are set to 1, `false` otherwise.
+     */
+    template <typename F>
+    bool is_set() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask) == F::mask;
+    }
+
+    //! Is field clear bool method.
+    /**
+     * @tparam F Field type (from a register of the pack).
+     * @return `true` if all the bits are set to 0, `false` otherwise.
+     */
+    template <typename F>
+    bool is_clear() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask)
+               == typename F::type{0};
+    }
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_PACKSNAPSHOT_H
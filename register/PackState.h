@@ -0,0 +1,382 @@
+//! Register pack state implementation.
+/**
+ * @file      PackState.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the implementation of register pack states, which
+ * are used to save and restore a list of registers of a pack (e.g., for
+ * peripherals losing their state in low-power modes). The list of registers
+ * is defined at compile time, and the state storage is a statically sized
+ * object holding one value per saved register.
+ */
+
+
+#ifndef CPPREG_PACKSTATE_H
+#define CPPREG_PACKSTATE_H
+
+
+#include "AccessPolicy.h"
+#include "Internals.h"
+#include "MergeWrite.h"
+#include "RegisterPack.h"
+
+
+namespace cppreg {
+
+
+//! Register bits to be saved and restored.
+/**
+ * @tparam Register Register type.
+ * @tparam restore_mask Mask of the bits to be saved and restored.
+ *
+ * This is the pack state item for a register given with an explicit mask:
+ * as the register type does not know its fields, the mask should not
+ * include the bits of fields that cannot be restored without side effects
+ * (e.g., read-only, read-to-clear or write-1-to-clear fields).
+ */
+template <typename Register, typename Register::type restore_mask>
+struct MaskedRegister {
+
+    //! Register type.
+    using reg = Register;    // NOLINT
+
+    //! Restored bits mask.
+    constexpr static auto mask = restore_mask;
+};
+
+
+namespace internals {
+
+
+//! Restorable policy check.
+/**
+ * @tparam P Access policy type.
+ *
+ * This will only derived from std::true_type if the fields using the
+ * policy can be saved (i.e., read) and restored (i.e., written back)
+ * without side effects: the policy has to be a read-write or atomic policy
+ * (or be derived from one) and not a read-to-clear, write-only or
+ * write-1-to-clear/set policy (including derived policies).
+ */
+template <typename P>
+struct is_restorable_policy    // NOLINT
+    : std::integral_constant<
+          bool,
+          (std::is_base_of<read_write, P>::value
+           || is_atomic_policy<P>::value)
+              && !std::is_base_of<read_to_clear, P>::value
+              && !std::is_base_of<write_only, P>::value
+              && !is_write_1_policy<P>::value> {};
+
+
+//! Field type check.
+/**
+ * @tparam T Register or field type.
+ *
+ * This will only derived from std::true_type if the type is a field type
+ * (i.e., it has a parent register).
+ */
+template <typename T, typename = void>
+struct is_field_type : std::false_type {};    // NOLINT
+template <typename T>
+struct is_field_type<T,
+                     typename std::conditional<
+                         true,
+                         void,
+                         typename T::parent_register>::type>
+    : std::true_type {};
+
+
+//! Pack state entry.
+/**
+ * @tparam Register Register to be saved and restored.
+ * @tparam mask Combined mask of the restored bits.
+ *
+ * This holds the saved value of a given register.
+ */
+template <typename Register, typename Register::type mask>
+struct pack_state_entry {    // NOLINT
+
+    //! Register type.
+    using reg = Register;    // NOLINT
+
+    //! Register data type.
+    using type = typename Register::type;    // NOLINT
+
+    //! Combined mask.
+    constexpr static auto combined_mask = mask;
+
+    //! Saved value.
+    type saved_value;
+
+    //! Default constructor (reset value).
+    pack_state_entry() noexcept : saved_value{Register::reset} {};
+
+    //! Save method (single read).
+    void save() noexcept {
+        saved_value = Register::ro_mem_device();
+    }
+
+    //! Changed value check.
+    /**
+     * @return `true` if the saved value differs from the reset value for
+     * the restored bits, `false` otherwise.
+     */
+    bool is_dirty() const noexcept {
+        return static_cast<type>(saved_value & mask)
+               != static_cast<type>(Register::reset & mask);
+    }
+
+    //!@{ Helpers for restore method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
+
+    //! Restore method (no shadow value).
+    /**
+     * The restored bits are merged into the reset value, which is written
+     * with a single store (no read).
+     */
+    template <typename T = void>
+    void restore(if_no_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::rw_mem_device() = restored_value();
+    }
+
+    //! Restore method (w/ shadow value).
+    /**
+     * The shadow value is also set to the restored value.
+     */
+    template <typename T = void>
+    void restore(if_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::shadow::shadow_value = restored_value();
+        Register::rw_mem_device() = Register::shadow::shadow_value;
+    }
+
+    //! Restore method for changed values.
+    void restore_dirty() const noexcept {
+        if (is_dirty()) {
+            restore();
+        }
+    }
+
+private:
+    // Restored bits merged into the reset value.
+    type restored_value() const noexcept {
+        return static_cast<type>(
+            (Register::reset & static_cast<type>(~mask))
+            | (saved_value & mask));
+    }
+};
+
+
+//! Register or field to be saved and restored.
+/**
+ * @tparam Item Field type or MaskedRegister type.
+ *
+ * For a field only the field bits are restored, and only if the field
+ * policy is restorable. For a masked register the bits of the mask are
+ * restored. Registers cannot be used directly: their fields policies are
+ * not known, and restoring all the bits could write back read-only or
+ * write-1-to-clear bits.
+ */
+template <typename Item, bool is_field = is_field_type<Item>::value>
+struct pack_state_item {    // NOLINT
+
+    //! Register type.
+    using reg = Item;    // NOLINT
+
+    //! Restored bits mask.
+    constexpr static auto mask = type_mask<typename reg::type>::value;
+
+    //! Entry for a register without previous items.
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+
+    //! Entry merged with previous items of the same register.
+    template <typename E>
+    using merged = entry;    // NOLINT
+
+    // Registers are given with fields or with an explicit mask.
+    static_assert(is_field,
+                  "PackState:: registers have to be given as fields or as "
+                  "MaskedRegister items");
+};
+template <typename Register, typename Register::type restore_mask>
+struct pack_state_item<MaskedRegister<Register, restore_mask>, false> {
+    using reg = Register;    // NOLINT
+    constexpr static auto mask = restore_mask;
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+    template <typename E>
+    using merged =    // NOLINT
+        pack_state_entry<reg,
+                         static_cast<typename reg::type>(E::combined_mask
+                                                         | mask)>;
+};
+template <typename Item>
+struct pack_state_item<Item, true> {    // NOLINT
+    using reg = typename Item::parent_register;    // NOLINT
+    constexpr static auto mask =
+        is_restorable_policy<typename Item::policy>::value
+            ? Item::mask
+            : typename reg::type{0};
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+    template <typename E>
+    using merged =    // NOLINT
+        pack_state_entry<reg,
+                         static_cast<typename reg::type>(E::combined_mask
+                                                         | mask)>;
+};
+
+
+//! List of pack state entries (sorted by ascending register address).
+/**
+ * @tparam List List of entries.
+ * @tparam Items Registers or fields to be inserted.
+ *
+ * Items without restored bits are not inserted (see pack_write_insert),
+ * and the items of a PackIndexing are inserted one by one.
+ */
+template <typename List, typename... Items>
+struct pack_state_list {    // NOLINT
+    using type = List;    // NOLINT
+};
+template <typename List, typename Item, typename... Items>
+struct pack_state_list<List, Item, Items...>    // NOLINT
+    : pack_state_list<
+          typename std::conditional<
+              pack_state_item<Item>::mask == 0,
+              List,
+              typename pack_write_insert<List, pack_state_item<Item>>::type>::
+              type,
+          Items...> {};
+template <typename List, typename... Indexed, typename... Items>
+struct pack_state_list<List, PackIndexing<Indexed...>, Items...>    // NOLINT
+    : pack_state_list<List, Indexed..., Items...> {};
+
+
+//! Pack state storage.
+template <typename List>
+class pack_state_storage;    // NOLINT
+template <typename... Entries>
+class pack_state_storage<pack_write_list<Entries...>>    // NOLINT
+    : private Entries... {
+
+public:
+    //! Number of saved registers.
+    constexpr static const std::size_t n_regs = sizeof...(Entries);
+
+    //! Save method.
+    void save() noexcept {
+        const int expand[] = {0, (static_cast<Entries&>(*this).save(), 0)...};
+        static_cast<void>(expand);
+    }
+
+    //! Restore method.
+    void restore() const noexcept {
+        const int expand[] = {
+            0, (static_cast<const Entries&>(*this).restore(), 0)...};
+        static_cast<void>(expand);
+    }
+
+    //! Restore method for changed values.
+    void restore_dirty() const noexcept {
+        const int expand[] = {
+            0, (static_cast<const Entries&>(*this).restore_dirty(), 0)...};
+        static_cast<void>(expand);
+    }
+
+    //! Registers check.
+    template <typename RegisterPack>
+    using is_from_pack =    // NOLINT
+        is_pack_registers<RegisterPack, typename Entries::reg...>;
+};
+
+
+}    // namespace internals
+
+
+//! Register pack state implementation.
+/**
+ * @tparam RegisterPack Register pack type.
+ * @tparam Items Fields of the pack to be saved and restored, MaskedRegister
+ * types over registers of the pack, or PackIndexing types over fields.
+ *
+ * The items are grouped per register at compile time and the registers
+ * are saved and restored in ascending address order, with one access per
+ * register (i.e., the register size). For fields only the field bits are
+ * restored, and the fields which cannot be restored without side effects
+ * (read-only, read-to-clear, write-only, write-1-to-clear and
+ * write-1-to-set) are skipped; registers without restored bits are not
+ * saved. For masked registers the bits of the mask are restored.
+ *
+ * When restoring, the restored bits are merged into the register reset
+ * value which is written with a single store (i.e., the other bits are set
+ * to their reset values and no read is performed).
+ */
+template <typename RegisterPack, typename... Items>
+class PackState {
+
+private:
+    // Entries list and storage.
+    using storage_type =    // NOLINT
+        internals::pack_state_storage<typename internals::pack_state_list<
+            internals::pack_write_list<>,
+            Items...>::type>;
+
+    // State storage.
+    storage_type _storage;    // NOLINT
+
+public:
+    //! Number of saved registers.
+    constexpr static const std::size_t n_regs = storage_type::n_regs;
+
+    //! Save method.
+    /**
+     * This performs one read per saved register.
+     */
+    void save() noexcept {
+        _storage.save();
+    }
+
+    //! Restore method.
+    /**
+     * This performs one store per saved register.
+     */
+    void restore() const noexcept {
+        _storage.restore();
+    }
+
+    //! Restore method for changed values.
+    /**
+     * This only restores the registers for which the saved value differs
+     * from the reset value (for the restored bits); the registers are
+     * assumed to hold their reset values.
+     */
+    void restore_dirty() const noexcept {
+        _storage.restore_dirty();
+    }
+
+    //! Capture method.
+    /**
+     * @return A pack state with the saved registers values.
+     */
+    static PackState capture() noexcept {
+        PackState state;
+        state.save();
+        return state;
+    }
+
+    // Check that the registers belong to the pack.
+    static_assert(storage_type::template is_from_pack<RegisterPack>::value,
+                  "PackState:: register is not from the same pack");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_PACKSTATE_H
@@ -14,6 +14,7 @@
 
 #include "Memory.h"
 #include "MergeWrite.h"
+#include "RegisterValue.h"
 #include "ShadowValue.h"
 
 
@@ -26,6 +27,7 @@ namespace cppreg {
  * @tparam reg_size Register size enum value.
  * @tparam reset_value Register reset value (0x0 if unknown).
  * @tparam use_shadow shadow Boolean flag to enable shadow value.
+ * @tparam use_shadow_read Boolean flag to serve reads from the shadow value.
  *
  * This data structure will act as a container for fields and is
  * therefore limited to a strict minimum. It only carries information
@@ -36,18 +38,19 @@ namespace cppreg {
 template <Address reg_address,
           RegBitSize reg_size,
           typename TypeTraits<reg_size>::type reset_value = 0x0,
-          bool use_shadow = false>
+          bool use_shadow = false,
+          bool use_shadow_read = false>
 struct Register {
 
     //! Register base type.
     using type = typename TypeTraits<reg_size>::type;    // NOLINT
 
-    //! MMIO pointer type.
-    using MMIO = volatile type;
-
     //! Boolean flag for shadow value management.
     using shadow = Shadow<Register, use_shadow>;    // NOLINT
 
+    //! Boolean flag for shadow read management.
+    using shadow_read = ShadowRead<Register, use_shadow_read>;    // NOLINT
+
     //! Register base address.
     constexpr static auto base_address = reg_address;
 
@@ -60,6 +63,12 @@ struct Register {
     //! Register pack for memory device.
     using pack = RegisterPack<base_address, size / one_byte>;    // NOLINT
 
+    //! MMIO type (volatile type for the physical memory backend).
+    using MMIO = typename std::remove_reference<    // NOLINT
+        decltype(RegisterMemoryDevice<pack>::mem_device::template rw_memory<
+                 reg_size,
+                 0>())>::type;
+
     //! Memory modifier.
     /**
      * @return A reference to the writable register memory.
@@ -78,18 +87,67 @@ struct Register {
         return MemDevice::template ro_memory<reg_size, 0>();
     }
 
+    //! Shadow value resynchronization.
+    /**
+     * This reloads the shadow value from the register memory. This is only
+     * available for registers serving reads from the shadow value and should
+     * be used if the register content might have been modified by hardware.
+     */
+    static void resync() noexcept {
+        static_assert(shadow_read::value,
+                      "Register::resync:: shadow read is not enabled");
+        shadow::shadow_value = ro_mem_device();
+    }
+
+    //! Register value read function.
+    /**
+     * @return The register value (obtained with a single read).
+     *
+     * The fields can then be decoded from the value without accessing the
+     * register memory.
+     */
+    static RegisterValue<Register> read_value() noexcept {
+        return RegisterValue<Register>::load();
+    }
+
+    //! Fields match function.
+    /**
+     * @tparam Conditions Field match conditions (e.g., F::eq<value>,
+     * F::all_set or F::all_clear).
+     * @return `true` if all the conditions are satisfied, `false` otherwise.
+     *
+     * This performs a single read of the register (see
+     * RegisterValue::matches).
+     */
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+
     //! Merge write start function.
     /**
      * @tparam F Field on which to perform the first write operation.
      * @param value Value to be written to the field.
      * @return A merge write data structure to chain further writes.
      */
-    template <typename F>
-    static MergeWrite<typename F::parent_register, F::mask> merge_write(
-        const typename F::type value) noexcept {
-        const auto lhs = static_cast<type>(value << F::offset);
-        return MergeWrite<typename F::parent_register, F::mask>::create(
-            static_cast<type>(lhs & F::mask));
+    template <typename F,
+              typename T =
+                  MergeWrite<typename F::parent_register,
+                             F::mask,
+                             is_atomic_policy<typename F::policy>::value>>
+    static T merge_write(const typename F::value_type value) noexcept {
+
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "Register::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "Register::merge_write:: field is not writable");
+
+        const auto lhs = static_cast<type>(static_cast<type>(value)
+                                           << F::offset);
+        return T::create(static_cast<type>(lhs & F::mask));
     }
 
     //! Merge write start function for constant value.
@@ -99,25 +157,40 @@ struct Register {
      * @return A merge write data structure to chain further writes.
      */
     template <typename F,
-              type value,
-              typename T = MergeWrite_tmpl<typename F::parent_register,
-                                           F::mask,
-                                           F::offset,
-                                           value>>
+              typename F::value_type value,
+              typename T = MergeWrite_tmpl<
+                  typename F::parent_register,
+                  F::mask,
+                  F::offset,
+                  static_cast<type>(value),
+                  is_atomic_policy<typename F::policy>::value>>
     static T merge_write() noexcept {
 
         // Check overflow.
         static_assert(
-            internals::check_overflow<type, value, (F::mask >> F::offset)>::
-                value,
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
             "Register::merge_write<value>:: value too large for the field");
 
+        // Check that the field can be written with a plain write.
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "Register::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "Register::merge_write:: field is not writable");
+
         return T::create();
     }
 
     // Sanity check.
     static_assert(size != 0, "Register:: register definition with zero size");
 
+    // Shadow read requires a shadow value.
+    static_assert(use_shadow || !use_shadow_read,
+                  "Register:: shadow read requires shadow value to be enabled");
+
     // Enforce alignment.
     static_assert(internals::is_aligned<reg_address,
                                         TypeTraits<reg_size>::byte_size>::value,
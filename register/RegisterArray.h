@@ -0,0 +1,272 @@
+//! Register array implementation.
+/**
+ * @file      RegisterArray.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the definitions related to register arrays, that is,
+ * registers with the same layout repeated at a constant stride in a pack
+ * (e.g., DMA channels or timer capture/compare registers). The fields of a
+ * register array are defined once for all the elements and the elements
+ * can be accessed with compile-time indices or runtime indices.
+ */
+
+
+#ifndef CPPREG_REGISTERARRAY_H
+#define CPPREG_REGISTERARRAY_H
+
+
+#include "AccessPolicy.h"
+#include "Field.h"
+#include "Internals.h"
+#include "Mask.h"
+#include "RegisterPack.h"
+
+
+namespace cppreg {
+
+
+//! Register array implementation.
+/**
+ * @tparam RegisterPack Pack to which the registers belong.
+ * @tparam reg_size Register size enum value.
+ * @tparam first_bit_offset Offset in bits for the first register with
+ * respect to base.
+ * @tparam bit_stride Offset in bits between two consecutive registers.
+ * @tparam count Number of registers.
+ * @tparam reset_value Registers reset value (0x0 if unknown).
+ *
+ * The elements of the array are packed registers (see elem). A register
+ * array provides n_elems and elem, and can therefore be used with
+ * pack_loop. Runtime indexing (with address arithmetic) requires the pack
+ * memory device to provide plain volatile memory (e.g., physical or mapped
+ * memory); the index is required to be lower than count (this is not
+ * checked).
+ */
+template <typename RegisterPack,
+          RegBitSize reg_size,
+          std::uint32_t first_bit_offset,
+          std::uint32_t bit_stride,
+          std::size_t count,
+          typename TypeTraits<reg_size>::type reset_value = 0x0>
+struct RegisterArray {
+
+    //! Register pack.
+    using pack = RegisterPack;    // NOLINT
+
+    //! Register data type.
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+
+    //! Register size in bits.
+    constexpr static auto size = TypeTraits<reg_size>::bit_size;
+
+    //! Number of elements.
+    constexpr static const std::size_t n_elems = count;
+
+    //! Stride in bytes.
+    constexpr static const std::size_t stride_in_bytes = bit_stride / one_byte;
+
+    //! Element accessor.
+    template <std::size_t n>
+    using elem =    // NOLINT
+        PackedRegister<RegisterPack,
+                       reg_size,
+                       first_bit_offset + (n * bit_stride),
+                       reset_value>;
+
+    //! MMIO type (from the pack memory device).
+    using MMIO = typename elem<0>::MMIO;    // NOLINT
+
+    //! Memory modifier.
+    /**
+     * @param index Element index.
+     * @return A reference to the writable register memory.
+     */
+    static MMIO& rw_mem_device(const std::size_t index) noexcept {
+        static_assert(std::is_same<MMIO, volatile type>::value,
+                      "RegisterArray:: runtime indexing requires a memory "
+                      "device with plain memory");
+        return *(reinterpret_cast<MMIO*>(    // NOLINT
+            reinterpret_cast<std::uintptr_t>(&elem<0>::rw_mem_device())
+            + (index * stride_in_bytes)));
+    }
+
+    //! Memory accessor.
+    /**
+     * @param index Element index.
+     * @return A reference to the read-only register memory.
+     */
+    static const MMIO& ro_mem_device(const std::size_t index) noexcept {
+        return rw_mem_device(index);
+    }
+
+    // Safety checks: the registers cannot overlap and the last register
+    // cannot overflow the pack (the alignment is checked by the elements).
+    static_assert(count != 0U, "RegisterArray:: array has no element");
+    static_assert(bit_stride >= TypeTraits<reg_size>::bit_size,
+                  "RegisterArray:: stride is smaller than register size");
+    static_assert(
+        (bit_stride % TypeTraits<reg_size>::bit_size) == 0U,
+        "RegisterArray:: stride is not a multiple of the register size");
+    static_assert(TypeTraits<reg_size>::byte_size
+                          + ((first_bit_offset
+                              + ((count - 1U) * bit_stride))
+                             / one_byte)
+                      <= RegisterPack::size_in_bytes,
+                  "RegisterArray:: register array is overflowing the pack");
+};
+
+
+//! Register array field implementation.
+/**
+ * @tparam BaseArray Parent register array.
+ * @tparam field_width Field width.
+ * @tparam field_offset Field offset.
+ * @tparam AccessPolicy Access policy type.
+ *
+ * The field is defined once for all the elements of the array: the static
+ * methods take the element index as argument (a constant index is folded
+ * by the compiler into a fixed address). The complete field interface for
+ * a given element is available with at.
+ */
+template <typename BaseArray,
+          FieldWidth field_width,
+          FieldOffset field_offset,
+          typename AccessPolicy>
+struct ArrayField {
+
+    //! Parent register array for the field.
+    using parent_array = BaseArray;    // NOLINT
+
+    //! Field data type derived from register data type.
+    using type = typename parent_array::type;    // NOLINT
+
+    //! MMIO type.
+    using MMIO = typename parent_array::MMIO;    // NOLINT
+
+    //! Field policy.
+    using policy = AccessPolicy;    // NOLINT
+
+    //! Field width.
+    constexpr static auto width = field_width;
+
+    //! Field offset.
+    constexpr static auto offset = field_offset;
+
+    //! Field mask.
+    constexpr static auto mask = make_shifted_mask<type>(width, offset);
+
+    //! Element field accessor.
+    template <std::size_t n>
+    using at =    // NOLINT
+        Field<typename parent_array::template elem<n>, width, offset, policy>;
+
+    //! Field read method.
+    /**
+     * @param index Element index.
+     * @return Field value.
+     */
+    static type read(const std::size_t index) noexcept {
+        return policy::template read<MMIO, type, mask, offset>(
+            parent_array::ro_mem_device(index));
+    }
+
+    //! Field write value method.
+    /**
+     * @param index Element index.
+     * @param value Value to be written to the field.
+     */
+    static void write(const std::size_t index, const type value) noexcept {
+        policy::template write<MMIO, type, mask, offset>(
+            parent_array::rw_mem_device(index), value);
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam value Constant to be written to the field.
+     * @param index Element index.
+     */
+    template <type value>
+    static void write(const std::size_t index) noexcept {
+        policy::template write<MMIO, type, mask, offset, value>(
+            parent_array::rw_mem_device(index));
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "ArrayField::write<value>: value too large for the field");
+    }
+
+    //! Field set method.
+    /**
+     * @param index Element index.
+     */
+    static void set(const std::size_t index) noexcept {
+        policy::template set<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+
+    //! Field clear method.
+    /**
+     * @param index Element index.
+     */
+    static void clear(const std::size_t index) noexcept {
+        policy::template clear<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+
+    //! Field toggle method.
+    /**
+     * @param index Element index.
+     */
+    static void toggle(const std::size_t index) noexcept {
+        policy::template toggle<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+
+    //! Is field set bool method.
+    /**
+     * @param index Element index.
+     * @return `true` if all the bits are set to 1, `false` otherwise.
+     */
+    static bool is_set(const std::size_t index) noexcept {
+        return (read(index) == (mask >> offset));
+    }
+
+    //! Is field clear bool method.
+    /**
+     * @param index Element index.
+     * @return `true` if all the bits are set to 0, `false` otherwise.
+     */
+    static bool is_clear(const std::size_t index) noexcept {
+        return (read(index) == type{0});
+    }
+
+    // Consistency checking (see Field).
+    static_assert(parent_array::size >= width,
+                  "ArrayField:: field width is larger than register size");
+    static_assert(parent_array::size >= width + offset,
+                  "ArrayField:: offset + width is larger than register size");
+    static_assert(
+        width != FieldWidth{0},
+        "ArrayField:: defining a Field type of zero width is not allowed");
+    static_assert(!std::is_base_of<bit_band_read_write, AccessPolicy>::value
+                      || ((mask != type{0})
+                          && ((mask & (mask - 1U)) == type{0})),
+                  "ArrayField:: bit-band requires a single bit field");
+    static_assert(
+        internals::is_policy_alias_in_memory<
+            typename parent_array::template elem<0>>(
+            static_cast<const AccessPolicy*>(nullptr))
+            && internals::is_policy_alias_in_memory<
+                typename parent_array::template elem<parent_array::n_elems
+                                                     - 1>>(
+                static_cast<const AccessPolicy*>(nullptr)),
+        "ArrayField:: alias register is outside of the pack memory");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_REGISTERARRAY_H
@@ -28,6 +28,7 @@ namespace cppreg {
  * @tparam bit_offset Offset in bits for the register with respect to base.
  * @tparam reset_value Register reset value (0x0 if unknown).
  * @tparam use_shadow Boolean flag to enable shadow value.
+ * @tparam use_shadow_read Boolean flag to serve reads from the shadow value.
  *
  * This implementation is intended to be used when defining a register
  * that belongs to a peripheral group.
@@ -36,12 +37,14 @@ template <typename RegisterPack,
           RegBitSize reg_size,
           std::uint32_t bit_offset,
           typename TypeTraits<reg_size>::type reset_value = 0x0,
-          bool use_shadow = false>
+          bool use_shadow = false,
+          bool use_shadow_read = false>
 struct PackedRegister
     : Register<RegisterPack::pack_base + (bit_offset / one_byte),
                reg_size,
                reset_value,
-               use_shadow> {
+               use_shadow,
+               use_shadow_read> {
 
     //! Register pack.
     using pack = RegisterPack;    // NOLINT
@@ -51,13 +54,20 @@ struct PackedRegister
         Register<RegisterPack::pack_base + (bit_offset / one_byte),
                  reg_size,
                  reset_value,
-                 use_shadow>;
+                 use_shadow,
+                 use_shadow_read>;
+
+    //! MMIO type (from the pack memory device).
+    using MMIO = typename std::remove_reference<    // NOLINT
+        decltype(RegisterMemoryDevice<RegisterPack>::mem_device::
+                     template rw_memory<reg_size,
+                                        (bit_offset / one_byte)>())>::type;
 
     //! Memory modifier.
     /**
      * @return A reference to the writable register memory.
      */
-    static typename base_reg::MMIO& rw_mem_device() noexcept {
+    static MMIO& rw_mem_device() noexcept {
         using MemDevice =
             typename RegisterMemoryDevice<RegisterPack>::mem_device;
         return MemDevice::template rw_memory<reg_size,
@@ -68,13 +78,43 @@ struct PackedRegister
     /**
      * @return A reference to the read-only register memory.
      */
-    static const typename base_reg::MMIO& ro_mem_device() noexcept {
+    static const MMIO& ro_mem_device() noexcept {
         using MemDevice =
             typename RegisterMemoryDevice<RegisterPack>::mem_device;
         return MemDevice::template ro_memory<reg_size,
                                              (bit_offset / one_byte)>();
     }
 
+    //! Shadow value resynchronization.
+    /**
+     * This reloads the shadow value from the register memory (see
+     * Register::resync).
+     */
+    static void resync() noexcept {
+        static_assert(base_reg::shadow_read::value,
+                      "PackedRegister::resync:: shadow read is not enabled");
+        base_reg::shadow::shadow_value = ro_mem_device();
+    }
+
+    //! Register value read function.
+    /**
+     * @return The register value (see Register::read_value).
+     */
+    static RegisterValue<PackedRegister> read_value() noexcept {
+        return RegisterValue<PackedRegister>::load();
+    }
+
+    //! Fields match function.
+    /**
+     * @tparam Conditions Field match conditions.
+     * @return `true` if all the conditions are satisfied, `false` otherwise
+     * (see Register::matches).
+     */
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+
     // Safety check to detect if are overflowing the pack.
     static_assert(TypeTraits<reg_size>::byte_size + (bit_offset / one_byte)
                       <= RegisterPack::size_in_bytes,
@@ -94,6 +134,73 @@ struct PackedRegister
 };
 
 
+namespace internals {
+
+
+//! Strided field check implementation.
+/**
+ * @tparam F First field type.
+ * @tparam G Second field type (defines the stride).
+ * @tparam H Field type to be checked.
+ * @tparam index Index of the field to be checked.
+ *
+ * This derives from std::true_type if H has the same layout as F (data
+ * type, mask and policy), is in the same pack, is accessed through plain
+ * volatile memory without shadow value, and if its register address is
+ * F register address plus index times the (positive) stride.
+ */
+template <typename F, typename G, typename H, std::size_t index>
+struct is_strided_field    // NOLINT
+    : std::integral_constant<
+          bool,
+          std::is_same<typename H::type, typename F::type>::value
+              && std::is_same<typename H::policy, typename F::policy>::value
+              && std::is_same<typename H::MMIO,
+                              volatile typename F::type>::value
+              && std::is_same<typename RegisterMemoryDevice<
+                                  typename H::parent_register::pack>::
+                                  mem_device,
+                              typename RegisterMemoryDevice<
+                                  typename F::parent_register::pack>::
+                                  mem_device>::value
+              && (H::mask == F::mask)
+              && !H::parent_register::shadow::value
+              && !H::parent_register::shadow_read::value
+              && (G::parent_register::base_address
+                  >= F::parent_register::base_address)
+              && (H::parent_register::base_address
+                  == F::parent_register::base_address
+                         + (index
+                            * (G::parent_register::base_address
+                               - F::parent_register::base_address)))> {};
+
+
+//! Strided pack check implementation.
+/**
+ * @tparam Tuple Tuple of field types.
+ * @tparam index Index of the field to be checked (used for the recursion).
+ * @tparam n_elems Number of fields.
+ *
+ * This derives from std::true_type if all the fields are strided fields
+ * (i.e., evenly spaced fields with the same layout, see is_strided_field).
+ */
+template <typename Tuple, std::size_t index, std::size_t n_elems>
+struct is_strided_pack    // NOLINT
+    : std::integral_constant<
+          bool,
+          is_strided_field<
+              typename std::tuple_element<0, Tuple>::type,
+              typename std::tuple_element<(n_elems > 1) ? 1 : 0, Tuple>::type,
+              typename std::tuple_element<index, Tuple>::type,
+              index>::value
+              && is_strided_pack<Tuple, index + 1, n_elems>::value> {};
+template <typename Tuple, std::size_t n_elems>
+struct is_strided_pack<Tuple, n_elems, n_elems> : std::true_type {};
+
+
+}    // namespace internals
+
+
 //! Pack indexing structure.
 /**
  * @tparam T List of types (registers or fields) to index.
@@ -101,6 +208,11 @@ struct PackedRegister
  * This can be used to conveniently map indices over packed registers.
  * The order in the variadic parameter pack will define the indexing
  * (starting at zero).
+ *
+ * Runtime indices are supported by dispatch (which calls an operation
+ * through a table of per-element function pointers) and by the indexed
+ * field read and write methods. The index is required to be lower than
+ * n_elems (this is not checked).
  */
 template <typename... T>
 struct PackIndexing {
@@ -115,17 +227,305 @@ struct PackIndexing {
     //! Element accessor.
     template <std::size_t n>
     using elem = typename std::tuple_element<n, tuple_t>::type;    // NOLINT
+
+private:
+    // Strided pack check (for indexed field accesses).
+    template <typename Tuple>
+    using is_strided =    // NOLINT
+        internals::is_strided_pack<Tuple, 0, std::tuple_size<Tuple>::value>;
+
+    // Field data type (for indexed field accesses).
+    template <typename Tuple>
+    using value_t =    // NOLINT
+        typename std::tuple_element<0, Tuple>::type::type;
+
+    // Index sequence for the dispatch tables.
+    template <std::size_t... n>
+    struct indices {};    // NOLINT
+    template <std::size_t k, std::size_t... n>
+    struct make_indices : make_indices<k - 1, k - 1, n...> {};    // NOLINT
+    template <std::size_t... n>
+    struct make_indices<0, n...> {    // NOLINT
+        using type = indices<n...>;    // NOLINT
+    };
+
+    // Dispatch table implementation (functor type).
+    template <typename Func, typename R, std::size_t... n>
+    static R dispatch_impl(const std::size_t index, indices<n...>) noexcept {
+        using entry_t = R (*)();
+        static const entry_t table[] = {&dispatch_entry<Func, R, n>...};
+        return table[index]();
+    }
+    template <typename Func, typename R, std::size_t n>
+    static R dispatch_entry() noexcept {
+        return Func().template operator()<n>();
+    }
+
+    // Dispatch table implementation (callable object).
+    template <typename Op, typename R, std::size_t... n>
+    static R dispatch_impl(const std::size_t index,
+                           Op& f,    // NOLINT
+                           indices<n...>) noexcept {
+        using entry_t = R (*)(Op&);
+        static const entry_t table[] = {&dispatch_entry<Op, R, n>...};
+        return table[index](f);
+    }
+    template <typename Op, typename R, std::size_t n>
+    static R dispatch_entry(Op& f) noexcept {    // NOLINT
+        return f(std::integral_constant<std::size_t, n>{});
+    }
+
+    // Field read and write entries (non-strided fields).
+    template <typename F>
+    static typename F::type read_entry() noexcept {
+        return F::read();
+    }
+    template <typename F>
+    static void write_entry(const typename F::type value) noexcept {
+        F::write(value);
+    }
+
+    // Strided field memory (address arithmetic from the first field).
+    template <typename F>
+    static typename F::MMIO& strided_memory(const std::size_t index) noexcept {
+        constexpr auto stride =
+            elem<(n_elems > 1) ? 1 : 0>::parent_register::base_address
+            - F::parent_register::base_address;
+        return *(reinterpret_cast<typename F::MMIO*>(    // NOLINT
+            reinterpret_cast<std::uintptr_t>(
+                &F::parent_register::rw_mem_device())
+            + (index * stride)));
+    }
+
+public:
+    //! Dispatch method (functor type).
+    /**
+     * @tparam Func Functor type (with a template call operator over the
+     * index, see for_loop).
+     * @param index Runtime index.
+     * @return The value returned by the functor call operator for index.
+     *
+     * This calls `Func().template operator()<index>()` through a table of
+     * function pointers (i.e., a single indirect call for any index).
+     */
+    template <typename Func,
+              typename R = decltype(Func().template operator()<0>())>
+    static R dispatch(const std::size_t index) noexcept {
+        return dispatch_impl<Func, R>(
+            index, typename make_indices<n_elems>::type{});
+    }
+
+    //! Dispatch method (callable object).
+    /**
+     * @tparam Op Callable object type.
+     * @param index Runtime index.
+     * @param f Callable object (e.g., polymorphic lambda with C++14).
+     * @return The value returned by the call to f for index.
+     *
+     * This calls `f(std::integral_constant<std::size_t, index>{})` through a
+     * table of function pointers (see for_loop::apply for the C++14 usage).
+     */
+    template <typename Op,
+              typename R = decltype(std::declval<Op&>()(
+                  std::integral_constant<std::size_t, 0>{}))>
+    static R dispatch(const std::size_t index, Op&& f) noexcept {
+        return dispatch_impl<typename std::remove_reference<Op>::type, R>(
+            index, f, typename make_indices<n_elems>::type{});
+    }
+
+    //! Indexed field read method (non-strided fields).
+    /**
+     * @param index Runtime index.
+     * @return The value of the field at index.
+     */
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<!is_strided<Tuple>::value,
+                                   value_t<Tuple>>::type
+    read(const std::size_t index) noexcept {
+        using entry_t = value_t<Tuple> (*)();
+        static const entry_t table[] = {&read_entry<T>...};
+        return table[index]();
+    }
+
+    //! Indexed field read method (strided fields).
+    /**
+     * @param index Runtime index.
+     * @return The value of the field at index.
+     *
+     * The fields are evenly spaced: the field memory is obtained by address
+     * arithmetic (i.e., a single indexed load).
+     */
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<is_strided<Tuple>::value,
+                                   value_t<Tuple>>::type
+    read(const std::size_t index) noexcept {
+        using F = elem<0>;
+        return F::policy::template read<typename F::MMIO,
+                                        typename F::type,
+                                        F::mask,
+                                        F::offset>(strided_memory<F>(index));
+    }
+
+    //! Indexed field write method (non-strided fields).
+    /**
+     * @param index Runtime index.
+     * @param value Value to be written to the field at index.
+     */
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<!is_strided<Tuple>::value>::type write(
+        const std::size_t index,
+        const value_t<Tuple> value) noexcept {
+        using entry_t = void (*)(value_t<Tuple>);
+        static const entry_t table[] = {&write_entry<T>...};
+        table[index](value);
+    }
+
+    //! Indexed field write method (strided fields).
+    /**
+     * @param index Runtime index.
+     * @param value Value to be written to the field at index.
+     *
+     * The fields are evenly spaced: the field memory is obtained by address
+     * arithmetic (i.e., a single indexed store or read-modify-write).
+     */
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<is_strided<Tuple>::value>::type write(
+        const std::size_t index,
+        const value_t<Tuple> value) noexcept {
+        using F = elem<0>;
+        F::policy::template write<typename F::MMIO,
+                                  typename F::type,
+                                  F::mask,
+                                  F::offset>(strided_memory<F>(index), value);
+    }
 };
 
 
+namespace internals {
+
+
+#if __cplusplus >= 201703L
+
+//! Unrolled loop implementation (fold expressions).
+/**
+ * @tparam start Start index value.
+ * @tparam stride Index increment.
+ * @tparam reverse Boolean flag to iterate in reverse order.
+ * @tparam Seq Index sequence (iteration counters).
+ *
+ * The calls are expanded with fold expressions, which avoids nested calls
+ * (one per iteration) and one template instantiation per index.
+ */
+template <std::size_t start, std::size_t stride, bool reverse, typename Seq>
+struct loop_unroll;    // NOLINT
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t... k>
+struct loop_unroll<start, stride, reverse, std::index_sequence<k...>> {
+
+    //! Index value for an iteration counter.
+    constexpr static std::size_t index(const std::size_t counter) noexcept {
+        return start
+               + (stride * (reverse ? (sizeof...(k) - 1U - counter) : counter));
+    }
+
+    //! Loop method (functor type).
+    template <typename Func>
+    static void apply() noexcept {
+        (Func().template operator()<index(k)>(), ...);
+    }
+
+    //! Loop method (callable object).
+    template <typename Op>
+    static void apply(Op& f) noexcept {    // NOLINT
+        (f(std::integral_constant<std::size_t, index(k)>{}), ...);
+    }
+};
+
+//! Loop implementation selection.
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+using loop_impl =    // NOLINT
+    loop_unroll<start, stride, reverse, std::make_index_sequence<n>>;
+
+#else
+
+//! Recursive loop implementation.
+/**
+ * @tparam start Start index value.
+ * @tparam stride Index increment.
+ * @tparam reverse Boolean flag to iterate in reverse order.
+ * @tparam n Number of iterations.
+ */
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+struct loop_recursive {    // NOLINT
+
+    //! Next iteration type.
+    using next =    // NOLINT
+        loop_recursive<start + stride, stride, reverse, n - 1U>;
+
+    //! Loop method (functor type).
+    template <typename Func>
+    static void apply() noexcept {
+        if (!reverse) {
+            Func().template operator()<start>();
+        }
+        next::template apply<Func>();
+        if (reverse) {
+            Func().template operator()<start>();
+        }
+    }
+
+    //! Loop method (callable object).
+    template <typename Op>
+    static void apply(Op& f) noexcept {    // NOLINT
+        if (!reverse) {
+            f(std::integral_constant<std::size_t, start>{});
+        }
+        next::apply(f);
+        if (reverse) {
+            f(std::integral_constant<std::size_t, start>{});
+        }
+    }
+};
+template <std::size_t start, std::size_t stride, bool reverse>
+struct loop_recursive<start, stride, reverse, 0U> {
+    template <typename Func>
+    static void apply() noexcept {}
+    template <typename Op>
+    static void apply(Op&) noexcept {}    // NOLINT
+};
+
+//! Loop implementation selection.
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+using loop_impl = loop_recursive<start, stride, reverse, n>;    // NOLINT
+
+#endif    // __cplusplus 201703L
+
+
+}    // namespace internals
+
+
 //! Template for loop implementation.
 /**
  * @tparam start Start index value.
  * @tparam end End index value.
+ *
+ * With C++17 the loops are expanded with fold expressions (flat sequence of
+ * calls); otherwise a recursive implementation is used.
  */
 template <std::size_t start, std::size_t end>
 struct for_loop {    // NOLINT
 
+private:
+    // Loop implementation for a given stride.
+    template <std::size_t stride, bool reverse>
+    using impl =    // NOLINT
+        internals::loop_impl<start,
+                             stride,
+                             reverse,
+                             ((end > start) && (stride != 0U))
+                                 ? ((end - start + stride - 1U) / stride)
+                                 : 0U>;
+
+public:
     //! Loop method.
     /**
      * @tparam Func Function to be called at each iteration.
@@ -134,10 +534,31 @@ struct for_loop {    // NOLINT
      */
     template <typename Func>
     static void apply() noexcept {
-        Func().template operator()<start>();
-        if (start < end) {
-            for_loop<start + 1, end>::template apply<Func>();
-        }
+        impl<1U, false>::template apply<Func>();
+    }
+
+    //! Reverse loop method.
+    /**
+     * @tparam Func Function to be called at each iteration.
+     *
+     * This will call Op for the range [start, end) in reverse order.
+     */
+    template <typename Func>
+    static void apply_reverse() noexcept {
+        impl<1U, true>::template apply<Func>();
+    }
+
+    //! Strided loop method.
+    /**
+     * @tparam stride Index increment.
+     * @tparam Func Function to be called at each iteration.
+     *
+     * This will call Op for start, start + stride, ... (lower than end).
+     */
+    template <std::size_t stride, typename Func>
+    static void apply_strided() noexcept {
+        static_assert(stride != 0U, "for_loop:: stride cannot be zero");
+        impl<stride, false>::template apply<Func>();
     }
 
 #if __cplusplus >= 201402L
@@ -153,21 +574,29 @@ struct for_loop {    // NOLINT
      */
     template <typename Op>
     static void apply(Op&& f) noexcept {
-        if (start < end) {
-            f(std::integral_constant<std::size_t, start>{});
-            for_loop<start + 1, end>::apply(std::forward<Op>(f));
-        };
+        impl<1U, false>::apply(f);
     }
-#endif    // __cplusplus 201402L
-};
-template <std::size_t end>
-struct for_loop<end, end> {
-    template <typename Func>
-    static void apply() noexcept {}
-#if __cplusplus >= 201402L
+
+    //! Reverse apply method.
+    /**
+     * @tparam Op Operator type to be called (see apply).
+     */
     template <typename Op>
-    static void apply(Op&&) noexcept {}    // NOLINT
-#endif                                     // __cplusplus 201402L
+    static void apply_reverse(Op&& f) noexcept {
+        impl<1U, true>::apply(f);
+    }
+
+    //! Strided apply method.
+    /**
+     * @tparam stride Index increment.
+     * @tparam Op Operator type to be called (see apply).
+     */
+    template <std::size_t stride, typename Op>
+    static void apply_strided(Op&& f) noexcept {
+        static_assert(stride != 0U, "for_loop:: stride cannot be zero");
+        impl<stride, false>::apply(f);
+    }
+#endif    // __cplusplus 201402L
 };
 
 
@@ -0,0 +1,351 @@
+//! Register value implementation.
+/**
+ * @file      RegisterValue.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * A register value holds a copy of the content of a register (obtained with
+ * a single read). The fields of the register can then be decoded and
+ * modified without accessing the register memory, and the value can be
+ * written back to the register with a single store.
+ */
+
+
+#ifndef CPPREG_REGISTERVALUE_H
+#define CPPREG_REGISTERVALUE_H
+
+
+#include "AccessPolicy.h"
+#include "Barrier.h"
+#include "Internals.h"
+
+
+namespace cppreg {
+
+
+namespace internals {
+
+
+//! Field match condition.
+/**
+ * @tparam F Field type.
+ * @tparam value Expected field value.
+ *
+ * This holds the field mask and the expected value shifted at the field
+ * offset (see Field::eq).
+ */
+template <typename F, typename F::type value>
+struct field_match {    // NOLINT
+
+    //! Field type.
+    using field = F;    // NOLINT
+
+    //! Field mask.
+    constexpr static auto mask = F::mask;
+
+    //! Expected value (shifted and masked).
+    constexpr static auto expected =
+        static_cast<typename F::type>((value << F::offset) & F::mask);
+
+    // Check for overflow.
+    static_assert(
+        check_overflow<typename F::type, value, (F::mask >> F::offset)>::
+            value,
+        "Field::eq<value>: value too large for the field");
+};
+
+
+//! Combined match conditions.
+/**
+ * @tparam Register Register type.
+ * @tparam Conditions Field match conditions.
+ *
+ * This combines the masks and expected values of the conditions, and checks
+ * that the fields are from the register and that the conditions are not
+ * contradictory (i.e., different values expected for the same bits).
+ */
+template <typename Register, typename... Conditions>
+struct match_conditions {    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    constexpr static const type mask = 0;
+    constexpr static const type expected = 0;
+    constexpr static const bool from_register = true;
+    constexpr static const bool consistent = true;
+};
+template <typename Register, typename C, typename... Conditions>
+struct match_conditions<Register, C, Conditions...> {    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    using tail = match_conditions<Register, Conditions...>;    // NOLINT
+    constexpr static const type mask =
+        static_cast<type>(C::mask | tail::mask);
+    constexpr static const type expected =
+        static_cast<type>(C::expected | tail::expected);
+    constexpr static const bool from_register =
+        std::is_base_of<Register, typename C::field::parent_register>::value
+        && tail::from_register;
+    constexpr static const bool consistent =
+        ((C::expected ^ tail::expected) & C::mask & tail::mask) == 0
+        && tail::consistent;
+};
+
+
+}    // namespace internals
+
+
+//! Register value implementation.
+/**
+ * @tparam Register Register type.
+ *
+ * The fields used with a register value are required to be from the
+ * register type (or from a type deriving from it).
+ */
+template <typename Register>
+class RegisterValue {
+
+public:
+    //! Register data type.
+    using type = typename Register::type;    // NOLINT
+
+private:
+    // Register content.
+    type _value;    // NOLINT
+
+    // Field check helper.
+    template <typename F>
+    using is_field =    // NOLINT
+        std::is_base_of<Register, typename F::parent_register>;
+
+    // Writable field check (see DeferredWrite).
+    template <typename F>
+    static void check_writable() noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        static_assert(!is_atomic_policy<typename F::policy>::value,
+                      "RegisterValue:: atomic fields are not supported");
+        static_assert(
+            !std::is_base_of<write_1_to_clear, typename F::policy>::value
+                && !std::is_base_of<write_1_to_set,
+                                    typename F::policy>::value,
+            "RegisterValue:: write-1-to-clear/set fields are not supported");
+        static_assert(
+            std::is_base_of<read_write, typename F::policy>::value
+                || std::is_base_of<write_only, typename F::policy>::value,
+            "RegisterValue:: field is not writable");
+    }
+
+    //!@{ Helpers for load method selection based on shadow read.
+    template <typename T>
+    using if_no_shadow_read =    // NOLINT
+        typename std::enable_if<!Register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_shadow_read =    // NOLINT
+        typename std::enable_if<Register::shadow_read::value, T>::type;
+    //!@}
+
+    //!@{ Helpers for store method selection based on shadow value.
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    //!@}
+
+public:
+    //! Constructor.
+    /**
+     * @param value Register content.
+     */
+    constexpr explicit RegisterValue(const type value) noexcept
+        : _value{value} {};
+
+    //! Load method (register memory).
+    /**
+     * @return The register value obtained with a single read.
+     */
+    template <typename T = RegisterValue>
+    static T load(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        return T{Register::ro_mem_device()};
+    }
+
+    //! Load method (shadow read).
+    /**
+     * @return The register value obtained from the shadow value.
+     */
+    template <typename T = RegisterValue>
+    static T load(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        return T{Register::shadow::shadow_value};
+    }
+
+    //! Raw value accessor.
+    /**
+     * @return The register content.
+     */
+    constexpr type raw() const noexcept {
+        return _value;
+    }
+
+    //! Field read method.
+    /**
+     * @tparam F Field type.
+     * @return The field value.
+     */
+    template <typename F>
+    typename F::value_type read() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<typename F::value_type>(
+            static_cast<type>((_value & F::mask) >> F::offset));
+    }
+
+    //! Is field set bool method.
+    /**
+     * @tparam F Field type.
+     * @return `true` if all the bits are set to 1, `false` otherwise.
+     */
+    template <typename F>
+    bool is_set() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<type>(_value & F::mask) == F::mask;
+    }
+
+    //! Is field clear bool method.
+    /**
+     * @tparam F Field type.
+     * @return `true` if all the bits are set to 0, `false` otherwise.
+     */
+    template <typename F>
+    bool is_clear() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<type>(_value & F::mask) == type{0};
+    }
+
+    //! Fields match method.
+    /**
+     * @tparam Conditions Field match conditions (e.g., F::eq<value>,
+     * F::all_set or F::all_clear).
+     * @return `true` if all the conditions are satisfied, `false` otherwise.
+     *
+     * The conditions are combined at compile time such that this is a
+     * single mask and compare.
+     */
+    template <typename... Conditions>
+    bool matches() const noexcept {
+        using combined = internals::match_conditions<Register, Conditions...>;
+        static_assert(combined::from_register,
+                      "RegisterValue:: field is not from the same register");
+        static_assert(combined::consistent,
+                      "RegisterValue::matches:: contradictory conditions");
+        return static_cast<type>(_value & combined::mask)
+               == combined::expected;
+    }
+
+    //! Field write method.
+    /**
+     * @tparam F Field type.
+     * @param value Value to be written to the field.
+     * @return A reference to the register value (to chain calls).
+     *
+     * This only modifies the register value (not the register memory).
+     */
+    template <typename F>
+    RegisterValue& write(const typename F::value_type value) noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(
+            (_value & static_cast<type>(~F::mask))
+            | (static_cast<type>(static_cast<type>(value) << F::offset)
+               & F::mask));
+        return *this;
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam F Field type.
+     * @tparam value Constant to be written to the field.
+     * @return A reference to the register value (to chain calls).
+     */
+    template <typename F, typename F::value_type value>
+    RegisterValue& write() noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "RegisterValue::write<value>: value too large for the field");
+
+        return write<F>(value);
+    }
+
+    //! Field set method.
+    /**
+     * @tparam F Field type.
+     * @return A reference to the register value (to chain calls).
+     */
+    template <typename F>
+    RegisterValue& set() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value | F::mask);
+        return *this;
+    }
+
+    //! Field clear method.
+    /**
+     * @tparam F Field type.
+     * @return A reference to the register value (to chain calls).
+     */
+    template <typename F>
+    RegisterValue& clear() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value & static_cast<type>(~F::mask));
+        return *this;
+    }
+
+    //! Field toggle method.
+    /**
+     * @tparam F Field type.
+     * @return A reference to the register value (to chain calls).
+     */
+    template <typename F>
+    RegisterValue& toggle() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value ^ F::mask);
+        return *this;
+    }
+
+    //! Store method (no shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the store.
+     *
+     * This writes the register value to the whole register (single store).
+     * All the bits are written back: in particular, write-1-to-clear bits
+     * which were read as 1 are cleared.
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void store(if_no_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::rw_mem_device() = _value;
+        Ordering::apply();
+    }
+
+    //! Store method (w/ shadow value).
+    /**
+     * @tparam Ordering Ordering policy applied after the store.
+     *
+     * This updates the shadow value and writes it to the whole register
+     * (single store). All the bits are written back (see above).
+     */
+    template <typename Ordering = no_barrier, typename T = void>
+    void store(if_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::shadow::shadow_value = _value;
+        Register::rw_mem_device() = _value;
+        Ordering::apply();
+    }
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_REGISTERVALUE_H
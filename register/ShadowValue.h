@@ -39,6 +39,30 @@ template <typename Register>
 typename Register::type Shadow<Register, true>::shadow_value = Register::reset;
 
 
+//! Shadow read generic implementation.
+/**
+ * @tparam Register Register type.
+ * @tparam use_shadow_read Boolean flag indicating if reads are served from
+ *                         the shadow value.
+ */
+template <typename Register, bool use_shadow_read>
+struct ShadowRead : std::false_type {};
+
+
+//! Shadow read specialization.
+/**
+ * @tparam Register Register type.
+ *
+ * This implementation is for register which use the shadow value as the
+ * authoritative copy of the register content: field reads and
+ * read-modify-write operations only use the shadow value and never read
+ * the register memory (write operations are still performed as a block
+ * from the shadow value).
+ */
+template <typename Register>
+struct ShadowRead<Register, true> : std::true_type {};
+
+
 }    // namespace cppreg
 
 
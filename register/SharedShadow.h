@@ -0,0 +1,483 @@
+//! Shared shadow value implementation.
+/**
+ * @file      SharedShadow.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides a shadow value for registers whose fields are written
+ * by several owners (e.g., the cores of a dual-core device, or different
+ * execution contexts). The fields are assigned to owners at compile time and
+ * the shadow value is split into partitions: one per owner for the fields it
+ * exclusively owns, and one for the fields owned by several owners. The
+ * register value is the combination of the partitions.
+ *
+ * - A lock hook is a type providing the static functions `void lock()` and
+ *   `void unlock()` (e.g., a hardware spinlock); the hook is responsible for
+ *   the memory ordering (i.e., acquire and release semantics).
+ * - A store policy is a type providing a `lock_free` boolean flag and a
+ *   static function `void store(MMIO&, T previous, T value, T (*combined)())`
+ *   called when a partition is updated from `previous` to `value`, where
+ *   `combined()` returns the register value; it reads all the partitions
+ *   and should only be called by store policies which are not lock-free.
+ */
+
+
+#ifndef CPPREG_SHAREDSHADOW_H
+#define CPPREG_SHAREDSHADOW_H
+
+
+#include "AccessPolicy.h"
+#include "Internals.h"
+#include "Memory.h"
+
+
+namespace cppreg {
+
+
+//! No lock hook.
+/**
+ * This can be used when the lock is never required (e.g., disjoint
+ * ownership with a lock-free store policy).
+ */
+struct no_lock {    // NOLINT
+    static void lock() noexcept {}
+    static void unlock() noexcept {}
+};
+
+
+//! Combined value store policy.
+/**
+ * The combined value is written to the whole register (single store). The
+ * partitions of different owners have to be combined and stored under the
+ * lock, hence the lock is used for all the writes (unless there is a single
+ * owner).
+ */
+struct locked_store {    // NOLINT
+
+    //! Lock-free flag for exclusively owned fields.
+    constexpr static const bool lock_free = false;
+
+    //! Store implementation.
+    template <typename MMIO, typename T>
+    static void store(MMIO& mmio_device,
+                      const T,
+                      const T,
+                      T (*const combined)()) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, combined());
+    }
+};
+
+
+//! Toggle alias store policy.
+/**
+ * @tparam toggle_offset Offset in bytes of the toggle alias register.
+ *
+ * This is intended for registers that come with a toggle (i.e., XOR) alias
+ * register: the bits in which the partition changed are written to the alias
+ * register (single store), which only modifies the bits of the partition.
+ * The writes to exclusively owned fields are then lock-free; the lock is
+ * only used for the fields owned by several owners.
+ */
+template <std::ptrdiff_t toggle_offset>
+struct toggle_alias_store {    // NOLINT
+
+    //! Lock-free flag for exclusively owned fields.
+    constexpr static const bool lock_free = true;
+
+    //! Store implementation.
+    template <typename MMIO, typename T>
+    static void store(MMIO& mmio_device,
+                      const T previous,
+                      const T value,
+                      T (*const)()) noexcept {
+        using alias = RegisterAlias<MMIO, toggle_offset>;
+        RegisterWrite<typename alias::alias_type,
+                      T,
+                      type_mask<T>::value,
+                      FieldOffset{0}>::write(alias::get(mmio_device),
+                                             static_cast<T>(previous ^ value));
+    }
+};
+
+
+namespace internals {
+
+
+//! Toggle alias store location check (see is_alias_in_memory).
+template <typename Register, std::ptrdiff_t toggle_offset>
+constexpr bool is_policy_alias_in_memory(
+    const toggle_alias_store<toggle_offset>*) noexcept {
+    return is_alias_in_memory<Register, toggle_offset>::value;
+}
+
+
+//! Combined field mask.
+/**
+ * @tparam T Register data type.
+ * @tparam Fields Field types.
+ */
+template <typename T, typename... Fields>
+struct combined_field_mask : std::integral_constant<T, 0> {};    // NOLINT
+template <typename T, typename F, typename... Fields>
+struct combined_field_mask<T, F, Fields...>    // NOLINT
+    : std::integral_constant<
+          T,
+          static_cast<T>(F::mask
+                         | combined_field_mask<T, Fields...>::value)> {};
+
+
+//! Shadow partitions overlap.
+/**
+ * @tparam T Register data type.
+ * @tparam seen Combined mask of the previous partitions.
+ * @tparam shared Bits owned by at least two of the previous partitions.
+ * @tparam Partitions Partition types.
+ *
+ * The value is the mask of the bits owned by several partitions.
+ */
+template <typename T, T seen, T shared, typename... Partitions>
+struct shadow_partitions_overlap    // NOLINT
+    : std::integral_constant<T, shared> {};
+template <typename T, T seen, T shared, typename P, typename... Partitions>
+struct shadow_partitions_overlap<T, seen, shared, P, Partitions...>    // NOLINT
+    : shadow_partitions_overlap<
+          T,
+          static_cast<T>(seen | P::template mask<T>::value),
+          static_cast<T>(shared | (seen & P::template mask<T>::value)),
+          Partitions...> {};
+
+
+//! Combined mask of shadow partitions.
+/**
+ * @tparam T Register data type.
+ * @tparam Partitions Partition types.
+ */
+template <typename T, typename... Partitions>
+struct shadow_partitions_mask : std::integral_constant<T, 0> {};    // NOLINT
+template <typename T, typename P, typename... Partitions>
+struct shadow_partitions_mask<T, P, Partitions...>    // NOLINT
+    : std::integral_constant<
+          T,
+          static_cast<T>(P::template mask<T>::value
+                         | shadow_partitions_mask<T, Partitions...>::value)> {
+};
+
+
+//! Owner partition lookup.
+/**
+ * @tparam Owner Owner type.
+ * @tparam Partitions Partition types.
+ *
+ * The type is the partition of the owner (void if there is none).
+ */
+template <typename Owner, typename... Partitions>
+struct owner_partition {    // NOLINT
+    using type = void;      // NOLINT
+};
+template <typename Owner, typename P, typename... Partitions>
+struct owner_partition<Owner, P, Partitions...> {    // NOLINT
+    using type = typename std::conditional<    // NOLINT
+        std::is_same<typename P::owner, Owner>::value,
+        P,
+        typename owner_partition<Owner, Partitions...>::type>::type;
+};
+
+
+//! Partition owners check.
+/**
+ * @tparam Partitions Partition types.
+ *
+ * This will only derived from std::true_type if there is at most one
+ * partition per owner.
+ */
+template <typename... Partitions>
+struct shadow_unique_owners : std::true_type {};    // NOLINT
+template <typename P, typename... Partitions>
+struct shadow_unique_owners<P, Partitions...>    // NOLINT
+    : std::integral_constant<
+          bool,
+          std::is_void<typename owner_partition<typename P::owner,
+                                                Partitions...>::type>::value
+              && shadow_unique_owners<Partitions...>::value> {};
+
+
+//! Shadow partition storage.
+/**
+ * @tparam Register Register type.
+ * @tparam Owner Owner type (void for the fields owned by several owners).
+ * @tparam mask Partition mask.
+ *
+ * The partition value is initialized with the register reset value.
+ */
+template <typename Register, typename Owner, typename Register::type mask>
+struct shadow_partition {    // NOLINT
+    static typename Register::type value;
+};
+template <typename Register, typename Owner, typename Register::type mask>
+typename Register::type shadow_partition<Register, Owner, mask>::value =
+    static_cast<typename Register::type>(Register::reset & mask);
+
+
+//! Scoped lock.
+/**
+ * @tparam Lock Lock hook type.
+ * @tparam enabled Boolean flag indicating if the lock is required.
+ */
+template <typename Lock, bool enabled>
+struct shadow_lock_guard {    // NOLINT
+    shadow_lock_guard() noexcept {
+        Lock::lock();
+    }
+    ~shadow_lock_guard() noexcept {
+        Lock::unlock();
+    }
+    shadow_lock_guard(const shadow_lock_guard&) = delete;
+    shadow_lock_guard& operator=(const shadow_lock_guard&) = delete;
+};
+template <typename Lock>
+struct shadow_lock_guard<Lock, false> {};    // NOLINT
+
+
+}    // namespace internals
+
+
+//! Shadow partition definition.
+/**
+ * @tparam Owner Owner type (e.g., a tag type for a core).
+ * @tparam Fields Fields of the register which are written by the owner.
+ */
+template <typename Owner, typename... Fields>
+struct ShadowPartition {
+
+    //! Owner type.
+    using owner = Owner;    // NOLINT
+
+    //! Combined mask of the fields (for a given register data type).
+    template <typename T>
+    using mask = internals::combined_field_mask<T, Fields...>;    // NOLINT
+};
+
+
+//! Shared shadow value implementation.
+/**
+ * @tparam Register Register type (without shadow value).
+ * @tparam Lock Lock hook type.
+ * @tparam Store Store policy type.
+ * @tparam Partitions Partition definitions (see ShadowPartition).
+ *
+ * The fields are written through the shared shadow value by their owners:
+ * - for a field exclusively owned by the writer, only the writer partition
+ *   is updated (which is not accessed by the other owners); with a lock-free
+ *   store policy no lock is taken,
+ * - for a field owned by several owners, the shared partition is updated
+ *   and stored under the lock.
+ * The register memory is never read and the bits which are not owned keep
+ * their reset values.
+ */
+template <typename Register,
+          typename Lock,
+          typename Store,
+          typename... Partitions>
+class SharedShadow {
+
+public:
+    //! Register data type.
+    using type = typename Register::type;    // NOLINT
+
+    //! Combined mask of the owned bits.
+    constexpr static const type owned_mask =
+        internals::shadow_partitions_mask<type, Partitions...>::value;
+
+    //! Mask of the bits owned by several owners.
+    constexpr static const type shared_mask =
+        internals::shadow_partitions_overlap<type,
+                                             type{0},
+                                             type{0},
+                                             Partitions...>::value;
+
+private:
+    // Owner partition mask (exclusively owned bits).
+    template <typename Owner>
+    using exclusive_mask =    // NOLINT
+        std::integral_constant<
+            type,
+            static_cast<type>(
+                internals::owner_partition<Owner, Partitions...>::type::
+                    template mask<type>::value
+                & static_cast<type>(~shared_mask))>;
+
+    // Owner partition storage.
+    template <typename Owner>
+    using exclusive_partition =    // NOLINT
+        internals::shadow_partition<Register,
+                                    Owner,
+                                    exclusive_mask<Owner>::value>;
+
+    // Shared partition storage.
+    using shared_partition =    // NOLINT
+        internals::shadow_partition<Register, void, shared_mask>;
+
+    // Partition update.
+    template <typename Owner, typename F>
+    static void update(const type mask, const type shifted_value) noexcept {
+
+        // Check that the field belongs to the owner.
+        using partition =
+            typename internals::owner_partition<Owner, Partitions...>::type;
+        static_assert(!std::is_void<partition>::value,
+                      "SharedShadow:: owner has no partition");
+        static_assert(
+            std::is_same<typename F::parent_register, Register>::value,
+            "SharedShadow:: field is not from the same register");
+        constexpr auto owned = partition::template mask<type>::value;
+        static_assert((F::mask & static_cast<type>(~owned)) == type{0},
+                      "SharedShadow:: field is not owned by the owner");
+
+        // Fields are either shared or exclusively owned.
+        constexpr auto is_shared = (F::mask & shared_mask) != type{0};
+        static_assert(!is_shared || ((F::mask & shared_mask) == F::mask),
+                      "SharedShadow:: field is partially shared");
+
+        // The lock is required for shared fields, and for exclusively owned
+        // fields if the store is not lock-free and other owners can store.
+        using storage =
+            typename std::conditional<is_shared,
+                                      shared_partition,
+                                      exclusive_partition<Owner>>::type;
+        internals::shadow_lock_guard<
+            Lock,
+            is_shared || (!Store::lock_free && (sizeof...(Partitions) > 1))>
+            guard;
+        static_cast<void>(guard);
+
+        const type previous = storage::value;
+        storage::value = static_cast<type>(
+            (previous & static_cast<type>(~mask)) | (shifted_value & mask));
+        Store::store(Register::rw_mem_device(),
+                     previous,
+                     storage::value,
+                     &combined);
+    }
+
+    // Combined value of the partitions.
+    static type combined() noexcept {
+        type result = static_cast<type>(Register::reset
+                                        & static_cast<type>(~owned_mask));
+        const int expand[] = {
+            0,
+            (result = static_cast<type>(
+                 result
+                 | exclusive_partition<typename Partitions::owner>::value),
+             0)...};
+        static_cast<void>(expand);
+        return static_cast<type>(result | shared_partition::value);
+    }
+
+public:
+    //! Combined shadow value accessor.
+    /**
+     * @return The register value as given by the partitions.
+     */
+    static type shadow_value() noexcept {
+        return combined();
+    }
+
+    //! Field read method.
+    /**
+     * @tparam F Field type.
+     * @return Field value (from the partitions, no read is performed).
+     */
+    template <typename F>
+    static typename F::value_type read() noexcept {
+        return static_cast<typename F::value_type>(
+            static_cast<type>((combined() & F::mask) >> F::offset));
+    }
+
+    //! Field write method.
+    /**
+     * @tparam Owner Owner writing the field.
+     * @tparam F Field type.
+     * @param value Value to be written to the field.
+     */
+    template <typename Owner, typename F>
+    static void write(const typename F::value_type value) noexcept {
+        update<Owner, F>(
+            F::mask,
+            static_cast<type>(static_cast<type>(value) << F::offset));
+    }
+
+    //! Field write constant method.
+    /**
+     * @tparam Owner Owner writing the field.
+     * @tparam F Field type.
+     * @tparam value Constant to be written to the field.
+     */
+    template <typename Owner, typename F, typename F::value_type value>
+    static void write() noexcept {
+
+        // Check for overflow.
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "SharedShadow::write<value>: value too large for the field");
+
+        write<Owner, F>(value);
+    }
+
+    //! Field set method.
+    /**
+     * @tparam Owner Owner writing the field.
+     * @tparam F Field type.
+     */
+    template <typename Owner, typename F>
+    static void set() noexcept {
+        update<Owner, F>(F::mask, F::mask);
+    }
+
+    //! Field clear method.
+    /**
+     * @tparam Owner Owner writing the field.
+     * @tparam F Field type.
+     */
+    template <typename Owner, typename F>
+    static void clear() noexcept {
+        update<Owner, F>(F::mask, type{0});
+    }
+
+    //! Store method.
+    /**
+     * This writes the combined value to the whole register (single store,
+     * under the lock), e.g., to initialize the register.
+     */
+    static void store() noexcept {
+        internals::shadow_lock_guard<Lock, true> guard;
+        static_cast<void>(guard);
+        RegisterWrite<typename Register::MMIO,
+                      type,
+                      type_mask<type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             combined());
+    }
+
+    // Each owner has a single partition.
+    static_assert(internals::shadow_unique_owners<Partitions...>::value,
+                  "SharedShadow:: owner has several partitions");
+
+    // The partitions replace the register shadow value.
+    static_assert(!Register::shadow::value,
+                  "SharedShadow:: register shadow value has to be disabled");
+
+    // The alias register has to be accessible with the memory backend.
+    static_assert(
+        internals::is_policy_alias_in_memory<Register>(
+            static_cast<const Store*>(nullptr)),
+        "SharedShadow:: alias register is outside of the pack memory");
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_SHAREDSHADOW_H
@@ -0,0 +1,304 @@
+//! Simulated memory device implementation.
+/**
+ * @file      SimulatedMemory.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides a memory device backed by ordinary RAM instead of
+ * the register physical addresses. This is intended to run code using
+ * cppreg on a host (e.g., for unit tests, benchmarks or sanitizers).
+ * Optional read and write hooks can be used to model the side effects of
+ * the peripheral.
+ */
+
+
+#ifndef CPPREG_SIMULATEDMEMORY_H
+#define CPPREG_SIMULATEDMEMORY_H
+
+
+#include "AccessPolicy.h"
+#include "Internals.h"
+#include "Traits.h"
+
+#include <array>
+
+
+namespace cppreg {
+
+
+//! Simulated memory hooks types.
+/**
+ * The read hook is called for each register read with the register address,
+ * size and content (which can be modified by the hook); it returns the value
+ * seen by the read operation.
+ * The write hook is called for each register write with the register
+ * address, size, content and written value; the hook is responsible for
+ * updating the content.
+ */
+struct SimulatedHooks {    // NOLINT
+
+    //! Read hook type.
+    using read_hook =    // NOLINT
+        std::uint64_t (*)(Address, RegBitSize, std::uint64_t&);
+
+    //! Write hook type.
+    using write_hook =    // NOLINT
+        void (*)(Address, RegBitSize, std::uint64_t&, std::uint64_t);
+};
+
+
+// Forward declaration.
+template <typename Device, RegBitSize reg_size, std::size_t byte_offset>
+class SimulatedRegister;
+
+
+//! Simulated memory device.
+/**
+ * @tparam mem_address Address of the memory device.
+ * @tparam mem_byte_size Memory device size in bytes.
+ * @tparam use_hooks Boolean flag to enable the read and write hooks.
+ *
+ * The memory is static RAM storage (zero-initialized). If the hooks are not
+ * enabled the accessors return references to the storage (which works with
+ * all access policies); otherwise they return SimulatedRegister objects
+ * invoking the hooks (which does not support the atomic policy).
+ */
+template <Address mem_address, std::size_t mem_byte_size, bool use_hooks>
+struct SimulatedMemoryDevice {
+
+    //! Memory device address.
+    constexpr static const Address base_address = mem_address;
+
+    //! Storage type.
+    /**
+     * The storage has the same alignment offset as the memory device
+     * address (which is checked when accessing the memory).
+     */
+    using MemStorage =    // NOLINT
+        std::array<volatile std::uint8_t,
+                   mem_byte_size + alignof(std::uint64_t)>;
+
+    //! Memory device storage.
+    alignas(std::uint64_t) static MemStorage _mem_storage;    // NOLINT
+
+    //! Read hook (register size, content).
+    static SimulatedHooks::read_hook _read_hook;    // NOLINT
+
+    //! Write hook (register size, content, written value).
+    static SimulatedHooks::write_hook _write_hook;    // NOLINT
+
+    //! Storage accessor (no hook invocation).
+    /**
+     * @tparam reg_size Register size.
+     * @tparam byte_offset Offset in bytes with respect to the device address.
+     * @return A reference to the storage.
+     *
+     * This is intended to inspect or modify the simulated memory (e.g., to
+     * model a hardware update) without invoking the hooks.
+     */
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static volatile typename TypeTraits<reg_size>::type& storage() noexcept {
+
+        // Check alignment and size.
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "SimulatedMemoryDevice:: request not aligned");
+        static_assert(byte_offset + TypeTraits<reg_size>::byte_size
+                          <= mem_byte_size,
+                      "SimulatedMemoryDevice:: request out of bounds");
+
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
+                &_mem_storage[(mem_address % alignof(std::uint64_t))
+                              + byte_offset]));
+    }
+
+    //! Reset method.
+    /**
+     * This sets all the bytes of the memory to zero and removes the hooks.
+     */
+    static void reset() noexcept {
+        for (auto& byte : _mem_storage) {
+            byte = 0U;
+        }
+        _read_hook = nullptr;
+        _write_hook = nullptr;
+    }
+
+private:
+    //!@{ Helpers for accessors selection based on hooks.
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    using rw_type =    // NOLINT
+        typename std::conditional<
+            use_hooks,
+            SimulatedRegister<SimulatedMemoryDevice, reg_size, byte_offset>,
+            volatile typename TypeTraits<reg_size>::type>::type;
+    template <typename T>
+    using if_no_hooks =    // NOLINT
+        typename std::enable_if<!use_hooks, T>::type;
+    template <typename T>
+    using if_hooks =    // NOLINT
+        typename std::enable_if<use_hooks, T>::type;
+    //!@}
+
+public:
+    //! Accessor (no hooks).
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static const T& ro_memory(if_no_hooks<T>* = nullptr) noexcept {
+        return storage<reg_size, byte_offset>();
+    }
+
+    //! Modifier (no hooks).
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static T& rw_memory(if_no_hooks<T>* = nullptr) noexcept {
+        return storage<reg_size, byte_offset>();
+    }
+
+    //! Accessor (w/ hooks).
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static const T& ro_memory(if_hooks<T>* = nullptr) noexcept {
+        return T::instance();
+    }
+
+    //! Modifier (w/ hooks).
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static T& rw_memory(if_hooks<T>* = nullptr) noexcept {
+        return T::instance();
+    }
+};
+
+//!@{ Static members definitions.
+template <Address a, std::size_t s, bool h>
+alignas(std::uint64_t)
+    typename SimulatedMemoryDevice<a, s, h>::MemStorage
+        SimulatedMemoryDevice<a, s, h>::_mem_storage = {};
+template <Address a, std::size_t s, bool h>
+SimulatedHooks::read_hook SimulatedMemoryDevice<a, s, h>::_read_hook =
+    nullptr;
+template <Address a, std::size_t s, bool h>
+SimulatedHooks::write_hook SimulatedMemoryDevice<a, s, h>::_write_hook =
+    nullptr;
+//!@}
+
+
+//! Simulated register implementation.
+/**
+ * @tparam Device Simulated memory device type.
+ * @tparam reg_size Register size.
+ * @tparam byte_offset Offset in bytes with respect to the device address.
+ *
+ * This is the memory device type used by registers of a simulated memory
+ * device with hooks: conversion to the register data type is a read and
+ * assignment is a write, both invoking the device hooks if set.
+ */
+template <typename Device, RegBitSize reg_size, std::size_t byte_offset>
+class SimulatedRegister {
+
+public:
+    //! Register data type.
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+
+    //! Register address.
+    constexpr static const Address address = Device::base_address + byte_offset;
+
+private:
+    // Default constructor (only used by instance).
+    SimulatedRegister() = default;
+
+public:
+    //!@{ Non-copyable.
+    SimulatedRegister(const SimulatedRegister&) = delete;
+    SimulatedRegister& operator=(const SimulatedRegister&) = delete;
+    //!@}
+
+    //! Instance accessor.
+    static SimulatedRegister& instance() noexcept {
+        static SimulatedRegister reg;
+        return reg;
+    }
+
+    //! Read operator.
+    operator type() const noexcept {    // NOLINT
+        volatile type& mem = Device::template storage<reg_size, byte_offset>();
+        if (Device::_read_hook == nullptr) {
+            return mem;
+        }
+        auto content = static_cast<std::uint64_t>(mem);
+        const auto value = Device::_read_hook(address, reg_size, content);
+        mem = static_cast<type>(content);
+        return static_cast<type>(value);
+    }
+
+    //! Write operator.
+    SimulatedRegister& operator=(const type value) noexcept {
+        volatile type& mem = Device::template storage<reg_size, byte_offset>();
+        if (Device::_write_hook == nullptr) {
+            mem = value;
+        } else {
+            auto content = static_cast<std::uint64_t>(mem);
+            Device::_write_hook(address, reg_size, content, value);
+            mem = static_cast<type>(content);
+        }
+        return *this;
+    }
+};
+
+
+//! Register alias specialization for simulated registers.
+/**
+ * The alias is the simulated register at the alias offset in the same
+ * simulated memory device.
+ */
+template <typename Device,
+          RegBitSize reg_size,
+          std::size_t reg_offset,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<SimulatedRegister<Device, reg_size, reg_offset>,
+                     byte_offset> {
+
+    //! Alias memory device type.
+    using alias_type =    // NOLINT
+        SimulatedRegister<Device,
+                          reg_size,
+                          static_cast<std::size_t>(
+                              static_cast<std::ptrdiff_t>(reg_offset)
+                              + byte_offset)>;
+
+    //! Alias memory device accessor.
+    static alias_type& get(
+        SimulatedRegister<Device, reg_size, reg_offset>&) noexcept {
+        return alias_type::instance();
+    }
+};
+
+
+//! Simulated memory backend.
+/**
+ * @tparam use_hooks Boolean flag to enable the read and write hooks.
+ *
+ * The register memory is simulated with RAM storage (one device per pack).
+ */
+template <bool use_hooks = false>
+struct simulated_memory {    // NOLINT
+
+    //! Memory device type.
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        SimulatedMemoryDevice<mem_address, mem_byte_size, use_hooks>;
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_SIMULATEDMEMORY_H
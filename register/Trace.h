@@ -0,0 +1,342 @@
+//! Register access tracing implementation.
+/**
+ * @file      Trace.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides a memory backend which records all the register
+ * accesses of a pack (address, size, value and access type) using a tracer
+ * type. Tracing is selected at compile time per pack: packs which are not
+ * using the traced backend are not affected at all.
+ *
+ * A tracer is a type providing a static function
+ * `void record(Address, RegBitSize, std::uint64_t, TraceAccess)`.
+ */
+
+
+#ifndef CPPREG_TRACE_H
+#define CPPREG_TRACE_H
+
+
+#include "AccessPolicy.h"
+#include "Atomic.h"
+#include "Traits.h"
+
+#include <array>
+
+
+namespace cppreg {
+
+
+//! Enumeration type for traced access type.
+enum class TraceAccess : std::uint8_t {
+    //! Register read.
+    read,    // NOLINT
+    //! Register write.
+    write    // NOLINT
+};
+
+
+//! Trace record.
+struct TraceRecord {    // NOLINT
+
+    //! Register address.
+    Address address;
+
+    //! Accessed value.
+    std::uint64_t value;
+
+    //! Register size.
+    RegBitSize size;
+
+    //! Access type.
+    TraceAccess access;
+};
+
+
+//! Ring buffer tracer.
+/**
+ * @tparam capacity Number of records in the buffer (power of two).
+ * @tparam Tag Tag type to define distinct buffers.
+ *
+ * The records are stored in a static ring buffer: when the buffer is full
+ * the oldest records are overwritten. Recording is lock-free (the buffer
+ * slot is obtained with an atomic increment) and can therefore be used from
+ * interrupt handlers.
+ */
+template <std::size_t capacity, typename Tag = void>
+struct ring_buffer_tracer {    // NOLINT
+
+    //! Buffer storage.
+    static std::array<TraceRecord, capacity> _records;    // NOLINT
+
+    //! Total number of records (including overwritten ones).
+    static volatile std::uint32_t _count;    // NOLINT
+
+    //! Record method.
+    /**
+     * @param address Register address.
+     * @param size Register size.
+     * @param value Accessed value.
+     * @param access Access type.
+     */
+    static void record(const Address address,
+                       const RegBitSize size,
+                       const std::uint64_t value,
+                       const TraceAccess access) noexcept {
+        const auto index = internals::atomic_modify<std::uint32_t>(
+            _count, [](const std::uint32_t current) {
+                return static_cast<std::uint32_t>(current + 1U);
+            });
+        _records[index & (capacity - 1U)] =
+            TraceRecord{address, value, size, access};
+    }
+
+    //! Number of available records.
+    static std::size_t size() noexcept {
+        return (_count < capacity) ? _count : capacity;
+    }
+
+    //! Record accessor.
+    /**
+     * @param n Record index (0 is the oldest available record).
+     * @return The record.
+     */
+    static const TraceRecord& get(const std::size_t n) noexcept {
+        return _records[(_count - size() + n) & (capacity - 1U)];
+    }
+
+    //! Reset method.
+    static void reset() noexcept {
+        _count = 0U;
+    }
+
+    // The capacity has to be a power of two.
+    static_assert((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U),
+                  "ring_buffer_tracer:: capacity is not a power of two");
+};
+
+//!@{ Static members definitions.
+template <std::size_t c, typename T>
+std::array<TraceRecord, c> ring_buffer_tracer<c, T>::_records = {};
+template <std::size_t c, typename T>
+volatile std::uint32_t ring_buffer_tracer<c, T>::_count = 0U;
+//!@}
+
+
+//! ITM tracer (Cortex-M).
+/**
+ * @tparam port ITM stimulus port.
+ *
+ * Each access is sent as three stimulus port writes: the register address
+ * (32 bits), the value (32 bits, the low and high words for 64-bit
+ * registers), and a 8-bit word with the access type (bit 4) and the register
+ * size (bits 0 to 3). The ITM and the stimulus port have to be enabled by
+ * the application.
+ */
+template <std::uint8_t port = 1U>
+struct itm_tracer {    // NOLINT
+
+    //! Stimulus port address.
+    constexpr static const Address port_address =
+        0xE0000000 + (Address{port} * 4U);
+
+    //! Record method.
+    /**
+     * @param address Register address.
+     * @param size Register size.
+     * @param value Accessed value.
+     * @param access Access type.
+     */
+    static void record(const Address address,
+                       const RegBitSize size,
+                       const std::uint64_t value,
+                       const TraceAccess access) noexcept {
+        send(static_cast<std::uint32_t>(address));
+        send(static_cast<std::uint32_t>(value));
+        if (size == RegBitSize::b64) {
+            send(static_cast<std::uint32_t>(value >> 32U));
+        }
+        send(static_cast<std::uint8_t>(
+            (static_cast<std::uint8_t>(access) << 4U)
+            | static_cast<std::uint8_t>(size)));
+    }
+
+private:
+    // Stimulus port write (waiting for the port to be ready).
+    template <typename T>
+    static void send(const T data) noexcept {
+        volatile T& stim = *(reinterpret_cast<volatile T*>(    // NOLINT
+            port_address));
+        while ((*(reinterpret_cast<const volatile std::uint32_t*>(    // NOLINT
+                    port_address))
+                & 0x1U)
+               == 0U) {
+        }
+        stim = data;
+    }
+
+    // Port index check.
+    static_assert(port < 32U, "itm_tracer:: invalid stimulus port");
+};
+
+
+// Forward declaration.
+template <typename TracedDevice, RegBitSize reg_size, std::size_t byte_offset>
+class TracedRegister;
+
+
+//! Traced memory device.
+/**
+ * @tparam Device Underlying memory device type.
+ * @tparam Tracer Tracer type.
+ * @tparam mem_address Address of the memory device.
+ *
+ * The accessors return TracedRegister objects which record each access and
+ * forward it to the underlying memory device.
+ */
+template <typename Device, typename Tracer, Address mem_address>
+struct TracedMemoryDevice {
+
+    //! Underlying memory device type.
+    using device = Device;    // NOLINT
+
+    //! Tracer type.
+    using tracer = Tracer;    // NOLINT
+
+    //! Memory device address.
+    constexpr static const Address base_address = mem_address;
+
+    //! Accessor.
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static const TracedRegister<TracedMemoryDevice, reg_size, byte_offset>&
+    ro_memory() noexcept {
+        return TracedRegister<TracedMemoryDevice, reg_size, byte_offset>::
+            instance();
+    }
+
+    //! Modifier.
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static TracedRegister<TracedMemoryDevice, reg_size, byte_offset>&
+    rw_memory() noexcept {
+        return TracedRegister<TracedMemoryDevice, reg_size, byte_offset>::
+            instance();
+    }
+};
+
+
+//! Traced register implementation.
+/**
+ * @tparam TracedDevice Traced memory device type.
+ * @tparam reg_size Register size.
+ * @tparam byte_offset Offset in bytes with respect to the device address.
+ *
+ * Conversion to the register data type is a traced read and assignment is
+ * a traced write.
+ */
+template <typename TracedDevice, RegBitSize reg_size, std::size_t byte_offset>
+class TracedRegister {
+
+public:
+    //! Register data type.
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+
+    //! Register address.
+    constexpr static const Address address =
+        TracedDevice::base_address + byte_offset;
+
+private:
+    // Underlying memory device and tracer.
+    using device = typename TracedDevice::device;    // NOLINT
+    using tracer = typename TracedDevice::tracer;    // NOLINT
+
+    // Default constructor (only used by instance).
+    TracedRegister() = default;
+
+public:
+    //!@{ Non-copyable.
+    TracedRegister(const TracedRegister&) = delete;
+    TracedRegister& operator=(const TracedRegister&) = delete;
+    //!@}
+
+    //! Instance accessor.
+    static TracedRegister& instance() noexcept {
+        static TracedRegister reg;
+        return reg;
+    }
+
+    //! Read operator.
+    operator type() const noexcept {    // NOLINT
+        const type value =
+            device::template ro_memory<reg_size, byte_offset>();
+        tracer::record(address,
+                       reg_size,
+                       static_cast<std::uint64_t>(value),
+                       TraceAccess::read);
+        return value;
+    }
+
+    //! Write operator.
+    TracedRegister& operator=(const type value) noexcept {
+        tracer::record(address,
+                       reg_size,
+                       static_cast<std::uint64_t>(value),
+                       TraceAccess::write);
+        device::template rw_memory<reg_size, byte_offset>() = value;
+        return *this;
+    }
+};
+
+
+//! Register alias specialization for traced registers.
+/**
+ * The alias is the traced register at the alias offset in the same memory
+ * device.
+ */
+template <typename TracedDevice,
+          RegBitSize reg_size,
+          std::size_t reg_offset,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<TracedRegister<TracedDevice, reg_size, reg_offset>,
+                     byte_offset> {
+
+    //! Alias memory device type.
+    using alias_type =    // NOLINT
+        TracedRegister<TracedDevice,
+                       reg_size,
+                       static_cast<std::size_t>(
+                           static_cast<std::ptrdiff_t>(reg_offset)
+                           + byte_offset)>;
+
+    //! Alias memory device accessor.
+    static alias_type& get(
+        TracedRegister<TracedDevice, reg_size, reg_offset>&) noexcept {
+        return alias_type::instance();
+    }
+};
+
+
+//! Traced memory backend.
+/**
+ * @tparam Backend Underlying memory backend type.
+ * @tparam Tracer Tracer type.
+ *
+ * The atomic access policy is not supported by this backend.
+ */
+template <typename Backend, typename Tracer>
+struct traced_memory {    // NOLINT
+
+    //! Memory device type.
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        TracedMemoryDevice<
+            typename Backend::template device<mem_address, mem_byte_size>,
+            Tracer,
+            mem_address>;
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_TRACE_H
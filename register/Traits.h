@@ -63,6 +63,41 @@ struct TypeTraits<RegBitSize::b64> {
 //!@}
 
 
+//! Register type traits based on width.
+/**
+ * @tparam bit_width Register width in bits (1 to 64).
+ *
+ * This provides the narrowest register size which can hold the given width
+ * (e.g., RegBitSize::b32 for a 24-bit register, see BusRegister).
+ */
+template <std::uint8_t bit_width>
+struct WidthTraits {
+
+    //! Register size.
+    constexpr static const auto size =
+        (bit_width <= 8U)
+            ? RegBitSize::b8
+            : ((bit_width <= 16U)
+                   ? RegBitSize::b16
+                   : ((bit_width <= 32U) ? RegBitSize::b32
+                                         : RegBitSize::b64));
+
+    //! Register data type.
+    using type = typename TypeTraits<size>::type;    // NOLINT
+
+    //! Register width in bits.
+    constexpr static const auto bit_size = bit_width;
+
+    //! Register width in bytes (rounded up).
+    constexpr static const auto byte_size =
+        std::uint8_t{(bit_width + 7U) / 8U};
+
+    // Sanity check.
+    static_assert((bit_width != 0U) && (bit_width <= 64U),
+                  "WidthTraits:: width must be between 1 and 64 bits");
+};
+
+
 }    // namespace cppreg
 
 
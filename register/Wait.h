@@ -0,0 +1,90 @@
+//! Wait policies and tick sources implementation.
+/**
+ * @file      Wait.h
+ * @author    Nicolas Clauvelin (nclauvelin@sendyne.com)
+ * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
+ *
+ * This header provides the wait policies (called at each iteration of a
+ * polling loop) and the tick sources (used for polling loop timeouts) used
+ * by the field wait methods.
+ *
+ * - A wait policy is a type providing a static function `void pause()`.
+ * - A tick source is a type providing a `tick_type` unsigned data type and a
+ *   static function `tick_type now()` returning a free running counter
+ *   (wrapping around is supported).
+ */
+
+
+#ifndef CPPREG_WAIT_H
+#define CPPREG_WAIT_H
+
+
+#include "cppreg_Defines.h"
+
+
+namespace cppreg {
+
+
+//! Busy wait policy.
+/**
+ * This performs a tight polling loop.
+ */
+struct busy_wait {    // NOLINT
+    static void pause() noexcept {}
+};
+
+
+#if defined(__arm__) || defined(__aarch64__)
+
+//! Wait for event policy (ARM).
+/**
+ * This suspends the core until an event occurs between polling iterations.
+ * This should only be used if the awaited condition is signaled by an event
+ * (e.g., a peripheral interrupt with SEVONPEND enabled), otherwise the loop
+ * might never complete.
+ */
+struct wfe_wait {    // NOLINT
+    static void pause() noexcept {
+        __asm__ volatile("wfe");
+    }
+};
+
+//! Yield policy (ARM).
+/**
+ * This executes a yield hint between polling iterations (e.g., for
+ * multithreading cores).
+ */
+struct yield_wait {    // NOLINT
+    static void pause() noexcept {
+        __asm__ volatile("yield");
+    }
+};
+
+#endif    // __arm__ || __aarch64__
+
+
+//! DWT cycle counter tick source (Cortex-M).
+/**
+ * This reads the DWT cycle counter (DWT->CYCCNT), which has to be enabled
+ * by the application (DEMCR.TRCENA and DWT_CTRL.CYCCNTENA).
+ */
+struct dwt_cycle_counter {    // NOLINT
+
+    //! Tick data type.
+    using tick_type = std::uint32_t;    // NOLINT
+
+    //! Cycle counter address.
+    constexpr static const Address cyccnt_address = 0xE0001004;
+
+    //! Current tick value.
+    static tick_type now() noexcept {
+        return *(reinterpret_cast<const volatile tick_type*>(    // NOLINT
+            cyccnt_address));
+    }
+};
+
+
+}    // namespace cppreg
+
+
+#endif    // CPPREG_WAIT_H
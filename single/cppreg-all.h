@@ -6,10 +6,15 @@
  * @copyright Copyright 2010-2022 Sendyne Corp. All rights reserved.
  */
 
+#include <array>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <limits>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 // cppreg_Defines.h
 #ifndef CPPREG_CPPREG_DEFINES_H
@@ -62,6 +67,22 @@ struct TypeTraits<RegBitSize::b64> {
     constexpr static auto bit_size = std::uint8_t{64};
     constexpr static auto byte_size = std::uint8_t{bit_size / 8};
 };
+template <std::uint8_t bit_width>
+struct WidthTraits {
+    constexpr static const auto size =
+        (bit_width <= 8U)
+            ? RegBitSize::b8
+            : ((bit_width <= 16U)
+                   ? RegBitSize::b16
+                   : ((bit_width <= 32U) ? RegBitSize::b32
+                                         : RegBitSize::b64));
+    using type = typename TypeTraits<size>::type;    // NOLINT
+    constexpr static const auto bit_size = bit_width;
+    constexpr static const auto byte_size =
+        std::uint8_t{(bit_width + 7U) / 8U};
+    static_assert((bit_width != 0U) && (bit_width <= 64U),
+                  "WidthTraits:: width must be between 1 and 64 bits");
+};
 }    
 #endif    
 
@@ -78,55 +99,215 @@ struct is_aligned    // NOLINT
     : std::integral_constant<
           bool,
           (static_cast<std::size_t>(address) & (alignment - 1)) == 0> {};
+template <typename P, typename Q>
+struct is_same_pack    // NOLINT
+    : std::integral_constant<bool,
+                             (P::pack_base == Q::pack_base)
+                                 && (P::size_in_bytes == Q::size_in_bytes)> {
+};
+template <typename R>
+struct register_byte_size    // NOLINT
+    : std::integral_constant<std::size_t,
+                             (R::size + one_byte - 1) / one_byte> {};
+template <typename RegisterPack, typename... Registers>
+struct is_pack_registers : std::true_type {};    // NOLINT
+template <typename RegisterPack, typename R, typename... Registers>
+struct is_pack_registers<RegisterPack, R, Registers...>    // NOLINT
+    : std::integral_constant<
+          bool,
+          is_same_pack<typename R::pack, RegisterPack>::value
+              && is_pack_registers<RegisterPack, Registers...>::value> {};
+template <Address address, std::size_t n_bytes, RegBitSize max_size>
+struct widest_access    // NOLINT
+    : std::conditional<
+          is_aligned<address, TypeTraits<max_size>::byte_size>::value
+              && ((n_bytes % TypeTraits<max_size>::byte_size) == 0),
+          std::integral_constant<RegBitSize, max_size>,
+          widest_access<address,
+                        n_bytes,
+                        static_cast<RegBitSize>(
+                            static_cast<std::uint8_t>(max_size) - 1U)>>::type {
+};
+template <Address address, std::size_t n_bytes>
+struct widest_access<address, n_bytes, RegBitSize::b8>
+    : std::integral_constant<RegBitSize, RegBitSize::b8> {};
+constexpr bool is_bit_band_address(const Address address) noexcept {
+    return ((address >= Address{0x20000000}) && (address < Address{0x20100000}))
+           || ((address >= Address{0x40000000})
+               && (address < Address{0x40100000}));
+}
+constexpr Address bit_band_alias(const Address address,
+                                 const FieldOffset bit) noexcept {
+    return (address & Address{0xF0000000}) + Address{0x02000000}
+           + ((address & Address{0x000FFFFF}) << 5U) + (Address{bit} << 2U);
+}
+template <typename T>
+constexpr FieldOffset bit_index(const T mask,
+                                const FieldOffset index = 0) noexcept {
+    return ((mask >> index) & T{1}) != T{0}
+               ? index
+               : bit_index<T>(mask, static_cast<FieldOffset>(index + 1U));
+}
 }    
 }    
 #endif    
 
-// Memory.h
-#ifndef CPPREG_DEV_MEMORY_H
-#define CPPREG_DEV_MEMORY_H
+// Atomic.h
+#ifndef CPPREG_ATOMIC_H
+#define CPPREG_ATOMIC_H
+#if !(defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)) \
+    && (__cplusplus >= 202002L)
+#include <atomic>
+#endif
 namespace cppreg {
-template <Address base_address, std::uint32_t pack_byte_size>
-struct RegisterPack {
-    constexpr static const Address pack_base = base_address;
-    constexpr static const std::uint32_t size_in_bytes = pack_byte_size;
+namespace internals {
+#if defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)
+template <typename T>
+struct exclusive_access {    // NOLINT
+    static_assert(sizeof(T) == 0,
+                  "exclusive_access:: data type not supported by target");
 };
-template <Address mem_address, std::size_t mem_byte_size>
-struct MemoryDevice {
-    using MemStorage = std::array<volatile std::uint8_t, mem_byte_size>;
-    static MemStorage& _mem_storage;    // NOLINT
-    template <RegBitSize reg_size, std::size_t byte_offset>
-    static const volatile typename TypeTraits<reg_size>::type& ro_memory() {
-        static_assert(
-            internals::is_aligned<mem_address + byte_offset,
-                                  std::alignment_of<typename TypeTraits<
-                                      reg_size>::type>::value>::value,
-            "MemoryDevice:: ro request not aligned");
-        return *(reinterpret_cast<const volatile    // NOLINT
-                                  typename TypeTraits<reg_size>::type*>(
-            &_mem_storage[byte_offset]));
+#if (__ARM_FEATURE_LDREX & 0x1)
+template <>
+struct exclusive_access<std::uint8_t> {
+    static std::uint8_t load(volatile std::uint8_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrexb %0, %1" : "=r"(result) : "Q"(*addr));
+        return static_cast<std::uint8_t>(result);
     }
-    template <RegBitSize reg_size, std::size_t byte_offset>
-    static volatile typename TypeTraits<reg_size>::type& rw_memory() {
-        static_assert(
-            internals::is_aligned<mem_address + byte_offset,
-                                  std::alignment_of<typename TypeTraits<
-                                      reg_size>::type>::value>::value,
-            "MemoryDevice:: rw request not aligned");
-        return *(    // NOLINTNEXTLINE
-            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
-                &_mem_storage[byte_offset]));
+    static bool store(volatile std::uint8_t* addr,
+                      const std::uint8_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strexb %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(static_cast<std::uint32_t>(value)));
+        return result == 0U;
     }
 };
-template <Address a, std::size_t s>    // NOLINTNEXTLINE
-typename MemoryDevice<a, s>::MemStorage& MemoryDevice<a, s>::_mem_storage =
-    // NOLINTNEXTLINE
-    *(reinterpret_cast<typename MemoryDevice<a, s>::MemStorage*>(a));
-template <typename RegisterPack>
-struct RegisterMemoryDevice {
-    using mem_device =    // NOLINT
-        MemoryDevice<RegisterPack::pack_base, RegisterPack::size_in_bytes>;
+#endif    
+#if (__ARM_FEATURE_LDREX & 0x2)
+template <>
+struct exclusive_access<std::uint16_t> {
+    static std::uint16_t load(volatile std::uint16_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrexh %0, %1" : "=r"(result) : "Q"(*addr));
+        return static_cast<std::uint16_t>(result);
+    }
+    static bool store(volatile std::uint16_t* addr,
+                      const std::uint16_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strexh %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(static_cast<std::uint32_t>(value)));
+        return result == 0U;
+    }
+};
+#endif    
+#if (__ARM_FEATURE_LDREX & 0x4)
+template <>
+struct exclusive_access<std::uint32_t> {
+    static std::uint32_t load(volatile std::uint32_t* addr) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("ldrex %0, %1" : "=r"(result) : "Q"(*addr));
+        return result;
+    }
+    static bool store(volatile std::uint32_t* addr,
+                      const std::uint32_t value) noexcept {
+        std::uint32_t result;
+        __asm__ volatile("strex %0, %2, %1"
+                         : "=&r"(result), "=Q"(*addr)
+                         : "r"(value));
+        return result == 0U;
+    }
+};
+#endif    
+#endif    
+template <typename T, typename Op>
+inline T atomic_modify(volatile T& mem, Op op) noexcept {
+#if defined(__ARM_FEATURE_LDREX) && !defined(__aarch64__)
+    T current;
+    do {
+        current = exclusive_access<T>::load(&mem);
+    } while (!exclusive_access<T>::store(&mem, op(current)));
+    return current;
+#elif defined(__arm__)
+    static_assert(sizeof(T) == 0,
+                  "atomic_modify:: no lock-free atomic access on ARM cores "
+                  "without exclusive access instructions");
+#elif defined(__cpp_lib_atomic_ref)
+    std::atomic_ref<T> ref(const_cast<T&>(mem));    // NOLINT
+    T current = ref.load(std::memory_order_relaxed);
+    while (!ref.compare_exchange_weak(
+        current, op(current), std::memory_order_relaxed)) {
+    }
+    return current;
+#elif defined(__GNUC__)
+    T current = __atomic_load_n(&mem, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&mem,
+                                        &current,
+                                        op(current),
+                                        true,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED)) {
+    }
+    return current;
+#else
+    static_assert(sizeof(T) == 0,
+                  "atomic_modify:: atomic access not supported by target");
+#endif
+}
+}    
+}    
+#endif    
+
+// Barrier.h
+#ifndef CPPREG_BARRIER_H
+#define CPPREG_BARRIER_H
+#if defined(__aarch64__)                           \
+    || (defined(__arm__) && defined(__ARM_ARCH) \
+        && ((__ARM_ARCH >= 7) || defined(__ARM_ARCH_6M__)))
+#define CPPREG_ARM_BARRIER_INSTRUCTIONS
+#endif
+namespace cppreg {
+struct no_barrier {    // NOLINT
+    static void apply() noexcept {}
+};
+struct compiler_barrier {    // NOLINT
+    static void apply() noexcept {
+        __asm__ volatile("" ::: "memory");
+    }
+};
+struct dmb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dmb sy" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
+};
+struct dsb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dsb sy" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
+};
+struct dsb_isb_barrier {    // NOLINT
+    static void apply() noexcept {
+#if defined(CPPREG_ARM_BARRIER_INSTRUCTIONS)
+        __asm__ volatile("dsb sy\n\tisb" ::: "memory");
+#else
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+    }
 };
+template <typename Ordering>
+inline void memory_barrier() noexcept {
+    Ordering::apply();
+}
 }    
 #endif    
 
@@ -193,6 +374,52 @@ struct RegisterWriteConstant {
         mmio_device = value;
     }
 };
+template <typename MMIO, typename T, T mask, FieldOffset offset>
+struct AtomicRegisterWrite {
+    template <typename U = void>
+    static void write(MMIO& mmio_device,
+                      T value,    // NOLINTNEXTLINE
+                      is_not_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        const auto rhs = static_cast<T>(static_cast<T>(value << offset) & mask);
+        internals::atomic_modify<T>(mmio_device, [rhs](const T current) {
+            return static_cast<T>(
+                static_cast<T>(current & static_cast<T>(~mask)) | rhs);
+        });
+    }
+    template <typename U = void>
+    static void write(MMIO& mmio_device,
+                      T value,    // NOLINTNEXTLINE
+                      is_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        mmio_device = value;
+    }
+};
+template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+struct AtomicRegisterWriteConstant {
+    template <typename U = void>
+    static void write(MMIO& mmio_device,    // NOLINTNEXTLINE
+                      is_not_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        internals::atomic_modify<T>(mmio_device, [](const T current) {
+            constexpr auto rhs =
+                static_cast<T>(static_cast<T>(value << offset) & mask);
+            return static_cast<T>(
+                static_cast<T>(current & static_cast<T>(~mask)) | rhs);
+        });
+    }
+    template <typename U = void>
+    static void write(MMIO& mmio_device,    // NOLINTNEXTLINE
+                      is_trivial<T, mask, offset, U>* = nullptr) noexcept {
+        mmio_device = value;
+    }
+};
+template <typename MMIO, std::ptrdiff_t byte_offset>
+struct RegisterAlias {
+    using alias_type = MMIO;    // NOLINT
+    static alias_type& get(MMIO& mmio_device) noexcept {
+        return *(reinterpret_cast<alias_type*>(    // NOLINT
+            reinterpret_cast<Address>(&mmio_device)
+            + static_cast<Address>(byte_offset)));
+    }
+};
 struct read_only {    // NOLINT
     template <typename MMIO, typename T, T mask, FieldOffset offset>
     static T read(const MMIO& mmio_device) noexcept {
@@ -241,71 +468,1058 @@ struct write_only {    // NOLINT
                               ((value << offset) & mask)>::write(mmio_device);
     }
 };
+struct write_1_to_clear : read_only {    // NOLINT
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(mmio_device);
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, static_cast<T>((value << offset) & mask));
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              static_cast<T>((value << offset) & mask)>::
+            write(mmio_device);
+    }
+};
+struct write_1_to_set : read_only {    // NOLINT
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(mmio_device);
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, static_cast<T>((value << offset) & mask));
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWriteConstant<MMIO,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              static_cast<T>((value << offset) & mask)>::
+            write(mmio_device);
+    }
+};
+struct read_to_clear : read_only {    // NOLINT
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        static_cast<void>(static_cast<T>(mmio_device));
+    }
+};
+template <std::ptrdiff_t set_offset, std::ptrdiff_t clear_offset>
+struct set_clear_alias : read_write {    // NOLINT
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, set_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, clear_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+};
+template <std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset,
+          std::ptrdiff_t toggle_offset>
+struct set_clear_toggle_alias    // NOLINT
+    : set_clear_alias<set_offset, clear_offset> {
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO& mmio_device) noexcept {
+        using alias = RegisterAlias<MMIO, toggle_offset>;
+        RegisterWriteConstant<typename alias::alias_type,
+                              T,
+                              type_mask<T>::value,
+                              FieldOffset{0},
+                              mask>::write(alias::get(mmio_device));
+    }
+};
+struct bit_band_read_write : read_write {};    // NOLINT
+struct atomic_read_write : read_only {    // NOLINT
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO& mmio_device, const T value) noexcept {
+        AtomicRegisterWrite<MMIO, T, mask, offset>::write(mmio_device, value);
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO, T, mask, offset, value>::write(
+            mmio_device);
+    }
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO, T, mask, FieldOffset{0}, mask>::
+            write(mmio_device);
+    }
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO& mmio_device) noexcept {
+        AtomicRegisterWriteConstant<MMIO,
+                                    T,
+                                    mask,
+                                    FieldOffset{0},
+                                    static_cast<T>(~mask)>::write(mmio_device);
+    }
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO& mmio_device) noexcept {
+        internals::atomic_modify<T>(mmio_device, [](const T current) {
+            return static_cast<T>(current ^ mask);
+        });
+    }
+};
+template <typename P>
+struct is_atomic_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<atomic_read_write, P>::value> {};
+template <typename P>
+struct is_write_1_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<write_1_to_clear, P>::value
+                                 || std::is_base_of<write_1_to_set,
+                                                    P>::value> {};
+template <typename P>
+struct is_plain_writable_policy    // NOLINT
+    : std::integral_constant<bool,
+                             std::is_base_of<read_write, P>::value
+                                 || std::is_base_of<write_only, P>::value> {};
+namespace internals {
+template <std::ptrdiff_t set_offset, std::ptrdiff_t clear_offset>
+std::true_type is_alias_policy_impl(    // NOLINT
+    const set_clear_alias<set_offset, clear_offset>*);
+std::false_type is_alias_policy_impl(const void*);    // NOLINT
 }    
-#endif    
-
-// Mask.h
-#ifndef CPPREG_MASK_H
-#define CPPREG_MASK_H
-namespace cppreg {
-template <typename Mask>
-constexpr Mask make_mask(const FieldWidth width) noexcept {
-    return width == 0U
-               ? static_cast<Mask>(0U)
-               : static_cast<Mask>(
-                   static_cast<Mask>(make_mask<Mask>(FieldWidth(
-                                         static_cast<FieldWidth>(width - 1U)))
-                                     << 1U)
-                   | 1U);
-}
-template <typename Mask>
-constexpr Mask make_shifted_mask(const FieldWidth width,
-                                 const FieldOffset offset) noexcept {
-    return static_cast<Mask>(make_mask<Mask>(width) << offset);
-}
+template <typename P>
+struct is_shadow_compatible_policy    // NOLINT
+    : std::integral_constant<
+          bool,
+          !std::is_base_of<write_1_to_clear, P>::value
+              && !std::is_base_of<write_1_to_set, P>::value
+              && !std::is_base_of<read_to_clear, P>::value
+              && !decltype(internals::is_alias_policy_impl(
+                  static_cast<const P*>(nullptr)))::value> {};
 }    
 #endif    
 
-// ShadowValue.h
-#ifndef CPPREG_SHADOWVALUE_H
-#define CPPREG_SHADOWVALUE_H
+// MappedMemory.h
+#ifndef CPPREG_MAPPEDMEMORY_H
+#define CPPREG_MAPPEDMEMORY_H
 namespace cppreg {
-template <typename Register, bool use_shadow>
-struct Shadow : std::false_type {};
-template <typename Register>
-struct Shadow<Register, true> : std::true_type {
-    static typename Register::type shadow_value;
+template <typename Mapping,
+          Address mem_address,
+          std::size_t mem_byte_size,
+          std::size_t granularity>
+struct MappedMemoryDevice {
+    constexpr static const Address base_address = mem_address;
+    constexpr static const Address map_address =
+        mem_address & ~static_cast<Address>(granularity - 1);
+    constexpr static const std::size_t map_length =
+        ((mem_address + mem_byte_size - map_address + granularity - 1)
+         / granularity)
+        * granularity;
+    static volatile std::uint8_t* _mem_base;    // NOLINT
+    static bool map() noexcept {
+        if (_mem_base == nullptr) {
+            auto* const region = static_cast<volatile std::uint8_t*>(
+                Mapping::map(map_address, map_length));
+            if (region != nullptr) {
+                _mem_base = region + (mem_address - map_address);
+            }
+        }
+        return _mem_base != nullptr;
+    }
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static const volatile typename TypeTraits<reg_size>::type& ro_memory() {
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MappedMemoryDevice:: ro request not aligned");
+        return *(reinterpret_cast<const volatile    // NOLINT
+                                  typename TypeTraits<reg_size>::type*>(
+            mapped_base() + byte_offset));
+    }
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static volatile typename TypeTraits<reg_size>::type& rw_memory() {
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MappedMemoryDevice:: rw request not aligned");
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
+                mapped_base() + byte_offset));
+    }
+private:
+    static volatile std::uint8_t* mapped_base() noexcept {
+        if ((_mem_base == nullptr) && !map()) {
+            std::abort();
+        }
+        return _mem_base;
+    }
+    static_assert((granularity != 0U)
+                      && ((granularity & (granularity - 1U)) == 0U),
+                  "MappedMemoryDevice:: granularity is not a power of two");
+};
+template <typename M, Address a, std::size_t s, std::size_t g>
+volatile std::uint8_t* MappedMemoryDevice<M, a, s, g>::_mem_base = nullptr;
+template <typename Mapping, std::size_t granularity = 4096U>
+struct mapped_memory {    // NOLINT
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        MappedMemoryDevice<Mapping, mem_address, mem_byte_size, granularity>;
 };
-template <typename Register>
-typename Register::type Shadow<Register, true>::shadow_value = Register::reset;
 }    
 #endif    
 
-// MergeWrite.h
-#ifndef CPPREG_MERGEWRITE_H
-#define CPPREG_MERGEWRITE_H
+// SimulatedMemory.h
+#ifndef CPPREG_SIMULATEDMEMORY_H
+#define CPPREG_SIMULATEDMEMORY_H
 namespace cppreg {
-template <typename Register,
-          typename Register::type mask,
-          FieldOffset offset,
-          typename Register::type value>
-class MergeWrite_tmpl {    // NOLINT
-private:
-    using base_type = typename Register::type;    // NOLINT
-    constexpr static auto _accumulated_value =    // NOLINT
-        base_type{(value << offset) & mask};
-    constexpr static auto _combined_mask = mask;    // NOLINT
-    template <typename F, base_type new_value>
-    using propagated =    // NOLINT
+struct SimulatedHooks {    // NOLINT
+    using read_hook =    // NOLINT
+        std::uint64_t (*)(Address, RegBitSize, std::uint64_t&);
+    using write_hook =    // NOLINT
+        void (*)(Address, RegBitSize, std::uint64_t&, std::uint64_t);
+};
+template <typename Device, RegBitSize reg_size, std::size_t byte_offset>
+class SimulatedRegister;
+template <Address mem_address, std::size_t mem_byte_size, bool use_hooks>
+struct SimulatedMemoryDevice {
+    constexpr static const Address base_address = mem_address;
+    using MemStorage =    // NOLINT
+        std::array<volatile std::uint8_t,
+                   mem_byte_size + alignof(std::uint64_t)>;
+    alignas(std::uint64_t) static MemStorage _mem_storage;    // NOLINT
+    static SimulatedHooks::read_hook _read_hook;    // NOLINT
+    static SimulatedHooks::write_hook _write_hook;    // NOLINT
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static volatile typename TypeTraits<reg_size>::type& storage() noexcept {
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "SimulatedMemoryDevice:: request not aligned");
+        static_assert(byte_offset + TypeTraits<reg_size>::byte_size
+                          <= mem_byte_size,
+                      "SimulatedMemoryDevice:: request out of bounds");
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
+                &_mem_storage[(mem_address % alignof(std::uint64_t))
+                              + byte_offset]));
+    }
+    static void reset() noexcept {
+        for (auto& byte : _mem_storage) {
+            byte = 0U;
+        }
+        _read_hook = nullptr;
+        _write_hook = nullptr;
+    }
+private:
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    using rw_type =    // NOLINT
+        typename std::conditional<
+            use_hooks,
+            SimulatedRegister<SimulatedMemoryDevice, reg_size, byte_offset>,
+            volatile typename TypeTraits<reg_size>::type>::type;
+    template <typename T>
+    using if_no_hooks =    // NOLINT
+        typename std::enable_if<!use_hooks, T>::type;
+    template <typename T>
+    using if_hooks =    // NOLINT
+        typename std::enable_if<use_hooks, T>::type;
+public:
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static const T& ro_memory(if_no_hooks<T>* = nullptr) noexcept {
+        return storage<reg_size, byte_offset>();
+    }
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static T& rw_memory(if_no_hooks<T>* = nullptr) noexcept {
+        return storage<reg_size, byte_offset>();
+    }
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static const T& ro_memory(if_hooks<T>* = nullptr) noexcept {
+        return T::instance();
+    }
+    template <RegBitSize reg_size,
+              std::size_t byte_offset,
+              typename T = rw_type<reg_size, byte_offset>>
+    static T& rw_memory(if_hooks<T>* = nullptr) noexcept {
+        return T::instance();
+    }
+};
+template <Address a, std::size_t s, bool h>
+alignas(std::uint64_t)
+    typename SimulatedMemoryDevice<a, s, h>::MemStorage
+        SimulatedMemoryDevice<a, s, h>::_mem_storage = {};
+template <Address a, std::size_t s, bool h>
+SimulatedHooks::read_hook SimulatedMemoryDevice<a, s, h>::_read_hook =
+    nullptr;
+template <Address a, std::size_t s, bool h>
+SimulatedHooks::write_hook SimulatedMemoryDevice<a, s, h>::_write_hook =
+    nullptr;
+template <typename Device, RegBitSize reg_size, std::size_t byte_offset>
+class SimulatedRegister {
+public:
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+    constexpr static const Address address = Device::base_address + byte_offset;
+private:
+    SimulatedRegister() = default;
+public:
+    SimulatedRegister(const SimulatedRegister&) = delete;
+    SimulatedRegister& operator=(const SimulatedRegister&) = delete;
+    static SimulatedRegister& instance() noexcept {
+        static SimulatedRegister reg;
+        return reg;
+    }
+    operator type() const noexcept {    // NOLINT
+        volatile type& mem = Device::template storage<reg_size, byte_offset>();
+        if (Device::_read_hook == nullptr) {
+            return mem;
+        }
+        auto content = static_cast<std::uint64_t>(mem);
+        const auto value = Device::_read_hook(address, reg_size, content);
+        mem = static_cast<type>(content);
+        return static_cast<type>(value);
+    }
+    SimulatedRegister& operator=(const type value) noexcept {
+        volatile type& mem = Device::template storage<reg_size, byte_offset>();
+        if (Device::_write_hook == nullptr) {
+            mem = value;
+        } else {
+            auto content = static_cast<std::uint64_t>(mem);
+            Device::_write_hook(address, reg_size, content, value);
+            mem = static_cast<type>(content);
+        }
+        return *this;
+    }
+};
+template <typename Device,
+          RegBitSize reg_size,
+          std::size_t reg_offset,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<SimulatedRegister<Device, reg_size, reg_offset>,
+                     byte_offset> {
+    using alias_type =    // NOLINT
+        SimulatedRegister<Device,
+                          reg_size,
+                          static_cast<std::size_t>(
+                              static_cast<std::ptrdiff_t>(reg_offset)
+                              + byte_offset)>;
+    static alias_type& get(
+        SimulatedRegister<Device, reg_size, reg_offset>&) noexcept {
+        return alias_type::instance();
+    }
+};
+template <bool use_hooks = false>
+struct simulated_memory {    // NOLINT
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        SimulatedMemoryDevice<mem_address, mem_byte_size, use_hooks>;
+};
+}    
+#endif    
+
+// Trace.h
+#ifndef CPPREG_TRACE_H
+#define CPPREG_TRACE_H
+namespace cppreg {
+enum class TraceAccess : std::uint8_t {
+    read,    // NOLINT
+    write    // NOLINT
+};
+struct TraceRecord {    // NOLINT
+    Address address;
+    std::uint64_t value;
+    RegBitSize size;
+    TraceAccess access;
+};
+template <std::size_t capacity, typename Tag = void>
+struct ring_buffer_tracer {    // NOLINT
+    static std::array<TraceRecord, capacity> _records;    // NOLINT
+    static volatile std::uint32_t _count;    // NOLINT
+    static void record(const Address address,
+                       const RegBitSize size,
+                       const std::uint64_t value,
+                       const TraceAccess access) noexcept {
+        const auto index = internals::atomic_modify<std::uint32_t>(
+            _count, [](const std::uint32_t current) {
+                return static_cast<std::uint32_t>(current + 1U);
+            });
+        _records[index & (capacity - 1U)] =
+            TraceRecord{address, value, size, access};
+    }
+    static std::size_t size() noexcept {
+        return (_count < capacity) ? _count : capacity;
+    }
+    static const TraceRecord& get(const std::size_t n) noexcept {
+        return _records[(_count - size() + n) & (capacity - 1U)];
+    }
+    static void reset() noexcept {
+        _count = 0U;
+    }
+    static_assert((capacity != 0U) && ((capacity & (capacity - 1U)) == 0U),
+                  "ring_buffer_tracer:: capacity is not a power of two");
+};
+template <std::size_t c, typename T>
+std::array<TraceRecord, c> ring_buffer_tracer<c, T>::_records = {};
+template <std::size_t c, typename T>
+volatile std::uint32_t ring_buffer_tracer<c, T>::_count = 0U;
+template <std::uint8_t port = 1U>
+struct itm_tracer {    // NOLINT
+    constexpr static const Address port_address =
+        0xE0000000 + (Address{port} * 4U);
+    static void record(const Address address,
+                       const RegBitSize size,
+                       const std::uint64_t value,
+                       const TraceAccess access) noexcept {
+        send(static_cast<std::uint32_t>(address));
+        send(static_cast<std::uint32_t>(value));
+        if (size == RegBitSize::b64) {
+            send(static_cast<std::uint32_t>(value >> 32U));
+        }
+        send(static_cast<std::uint8_t>(
+            (static_cast<std::uint8_t>(access) << 4U)
+            | static_cast<std::uint8_t>(size)));
+    }
+private:
+    template <typename T>
+    static void send(const T data) noexcept {
+        volatile T& stim = *(reinterpret_cast<volatile T*>(    // NOLINT
+            port_address));
+        while ((*(reinterpret_cast<const volatile std::uint32_t*>(    // NOLINT
+                    port_address))
+                & 0x1U)
+               == 0U) {
+        }
+        stim = data;
+    }
+    static_assert(port < 32U, "itm_tracer:: invalid stimulus port");
+};
+template <typename TracedDevice, RegBitSize reg_size, std::size_t byte_offset>
+class TracedRegister;
+template <typename Device, typename Tracer, Address mem_address>
+struct TracedMemoryDevice {
+    using device = Device;    // NOLINT
+    using tracer = Tracer;    // NOLINT
+    constexpr static const Address base_address = mem_address;
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static const TracedRegister<TracedMemoryDevice, reg_size, byte_offset>&
+    ro_memory() noexcept {
+        return TracedRegister<TracedMemoryDevice, reg_size, byte_offset>::
+            instance();
+    }
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static TracedRegister<TracedMemoryDevice, reg_size, byte_offset>&
+    rw_memory() noexcept {
+        return TracedRegister<TracedMemoryDevice, reg_size, byte_offset>::
+            instance();
+    }
+};
+template <typename TracedDevice, RegBitSize reg_size, std::size_t byte_offset>
+class TracedRegister {
+public:
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+    constexpr static const Address address =
+        TracedDevice::base_address + byte_offset;
+private:
+    using device = typename TracedDevice::device;    // NOLINT
+    using tracer = typename TracedDevice::tracer;    // NOLINT
+    TracedRegister() = default;
+public:
+    TracedRegister(const TracedRegister&) = delete;
+    TracedRegister& operator=(const TracedRegister&) = delete;
+    static TracedRegister& instance() noexcept {
+        static TracedRegister reg;
+        return reg;
+    }
+    operator type() const noexcept {    // NOLINT
+        const type value =
+            device::template ro_memory<reg_size, byte_offset>();
+        tracer::record(address,
+                       reg_size,
+                       static_cast<std::uint64_t>(value),
+                       TraceAccess::read);
+        return value;
+    }
+    TracedRegister& operator=(const type value) noexcept {
+        tracer::record(address,
+                       reg_size,
+                       static_cast<std::uint64_t>(value),
+                       TraceAccess::write);
+        device::template rw_memory<reg_size, byte_offset>() = value;
+        return *this;
+    }
+};
+template <typename TracedDevice,
+          RegBitSize reg_size,
+          std::size_t reg_offset,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<TracedRegister<TracedDevice, reg_size, reg_offset>,
+                     byte_offset> {
+    using alias_type =    // NOLINT
+        TracedRegister<TracedDevice,
+                       reg_size,
+                       static_cast<std::size_t>(
+                           static_cast<std::ptrdiff_t>(reg_offset)
+                           + byte_offset)>;
+    static alias_type& get(
+        TracedRegister<TracedDevice, reg_size, reg_offset>&) noexcept {
+        return alias_type::instance();
+    }
+};
+template <typename Backend, typename Tracer>
+struct traced_memory {    // NOLINT
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device =    // NOLINT
+        TracedMemoryDevice<
+            typename Backend::template device<mem_address, mem_byte_size>,
+            Tracer,
+            mem_address>;
+};
+}    
+#endif    
+
+// Memory.h
+#ifndef CPPREG_DEV_MEMORY_H
+#define CPPREG_DEV_MEMORY_H
+namespace cppreg {
+template <Address mem_address, std::size_t mem_byte_size>
+struct MemoryDevice;
+struct physical_memory {    // NOLINT
+    template <Address mem_address, std::size_t mem_byte_size>
+    using device = MemoryDevice<mem_address, mem_byte_size>;    // NOLINT
+};
+#if defined(CPPREG_SIMULATED_MEMORY)
+using default_memory_backend = simulated_memory<>;    // NOLINT
+#else
+using default_memory_backend = physical_memory;    // NOLINT
+#endif
+template <typename RegisterPack, typename... Entries>
+class PackMergeWrite_tmpl;
+template <typename RegisterPack, RegBitSize max_access_size>
+class PackSnapshot;
+template <typename RegisterPack, typename... Items>
+class PackState;
+template <Address base_address,
+          std::uint32_t pack_byte_size,
+          typename Backend = default_memory_backend>
+struct RegisterPack {
+    using backend = Backend;    // NOLINT
+    constexpr static const Address pack_base = base_address;
+    constexpr static const std::uint32_t size_in_bytes = pack_byte_size;
+    template <typename F,
+              typename F::value_type value,
+              typename T = decltype(PackMergeWrite_tmpl<RegisterPack>::create()
+                                        .template with<F, value>())>
+    static T merge_write() noexcept {
+        return PackMergeWrite_tmpl<RegisterPack>::create()
+            .template with<F, value>();
+    }
+    template <RegBitSize max_access_size = RegBitSize::b32,
+              typename T = PackSnapshot<RegisterPack, max_access_size>>
+    static T snapshot() noexcept {
+        return T::capture();
+    }
+    template <typename... Items,
+              typename T = PackState<RegisterPack, Items...>>
+    static T save() noexcept {
+        return T::capture();
+    }
+};
+template <Address mem_address, std::size_t mem_byte_size>
+struct MemoryDevice {
+    constexpr static const Address base_address = mem_address;
+    template <std::size_t byte_offset>
+    constexpr static Address address() noexcept {
+        return mem_address + byte_offset;
+    }
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static const volatile typename TypeTraits<reg_size>::type&
+    ro_memory() noexcept {
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MemoryDevice:: ro request not aligned");
+        return *(reinterpret_cast<const volatile    // NOLINT
+                                  typename TypeTraits<reg_size>::type*>(
+            mem_address + byte_offset));
+    }
+    template <RegBitSize reg_size, std::size_t byte_offset>
+    static volatile typename TypeTraits<reg_size>::type& rw_memory() noexcept {
+        static_assert(
+            internals::is_aligned<mem_address + byte_offset,
+                                  std::alignment_of<typename TypeTraits<
+                                      reg_size>::type>::value>::value,
+            "MemoryDevice:: rw request not aligned");
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile typename TypeTraits<reg_size>::type*>(
+                mem_address + byte_offset));
+    }
+};
+template <Address reg_address, FieldOffset bit>
+struct BitBandDevice {
+    constexpr static const Address alias_address =
+        internals::bit_band_alias(reg_address, bit);
+    static const volatile std::uint32_t& ro_memory() {
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<const volatile std::uint32_t*>(alias_address));
+    }
+    static volatile std::uint32_t& rw_memory() {
+        return *(    // NOLINTNEXTLINE
+            reinterpret_cast<volatile std::uint32_t*>(alias_address));
+    }
+    static_assert(internals::is_bit_band_address(reg_address
+                                                 + (bit / one_byte)),
+                  "BitBandDevice:: address is not in a bit-band region");
+};
+namespace internals {
+template <Address reg_address>
+struct bit_band_alias_policy : bit_band_read_write {
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static T read(const MMIO&) noexcept {
+        return static_cast<T>(alias<T, mask>::ro_memory());
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset>
+    static void write(MMIO&, const T value) noexcept {
+        alias<T, mask>::rw_memory() = static_cast<std::uint32_t>(value & 1u);
+    }
+    template <typename MMIO, typename T, T mask, FieldOffset offset, T value>
+    static void write(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = static_cast<std::uint32_t>(value & 1u);
+    }
+    template <typename MMIO, typename T, T mask>
+    static void set(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = 1u;
+    }
+    template <typename MMIO, typename T, T mask>
+    static void clear(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() = 0u;
+    }
+    template <typename MMIO, typename T, T mask>
+    static void toggle(MMIO&) noexcept {
+        alias<T, mask>::rw_memory() =
+            alias<T, mask>::ro_memory() ^ std::uint32_t{1};
+    }
+private:
+    template <typename T, T mask>
+    using alias =    // NOLINT
+        BitBandDevice<reg_address, internals::bit_index<T>(mask)>;
+};
+template <typename P, typename Register>
+struct register_policy {
+    using type = P;    // NOLINT
+};
+template <typename Register>
+struct register_policy<bit_band_read_write, Register> {
+    using type =    // NOLINT
+        typename std::conditional<
+            std::is_same<typename Register::pack::backend,
+                         physical_memory>::value
+                && std::is_same<typename Register::MMIO,
+                                volatile typename Register::type>::value
+                && is_bit_band_address(Register::base_address)
+                && is_bit_band_address(Register::base_address
+                                       + (Register::size / one_byte) - 1),
+            bit_band_alias_policy<Register::base_address>,
+            read_write>::type;
+};
+template <typename Register, std::ptrdiff_t byte_offset>
+struct is_alias_in_memory    // NOLINT
+    : std::integral_constant<
+          bool,
+          !std::is_same<typename Register::pack::backend,
+                        simulated_memory<false>>::value
+              || ((static_cast<std::ptrdiff_t>(Register::base_address
+                                               - Register::pack::pack_base)
+                   + byte_offset)
+                      >= 0
+                  && (static_cast<std::ptrdiff_t>(Register::base_address
+                                                  - Register::pack::pack_base)
+                      + byte_offset
+                      + static_cast<std::ptrdiff_t>(Register::size / one_byte))
+                         <= static_cast<std::ptrdiff_t>(
+                             Register::pack::size_in_bytes))> {};
+template <typename Register>
+constexpr bool is_policy_alias_in_memory(const void*) noexcept {
+    return true;
+}
+template <typename Register,
+          std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset>
+constexpr bool is_policy_alias_in_memory(
+    const set_clear_alias<set_offset, clear_offset>*) noexcept {
+    return is_alias_in_memory<Register, set_offset>::value
+           && is_alias_in_memory<Register, clear_offset>::value;
+}
+template <typename Register,
+          std::ptrdiff_t set_offset,
+          std::ptrdiff_t clear_offset,
+          std::ptrdiff_t toggle_offset>
+constexpr bool is_policy_alias_in_memory(
+    const set_clear_toggle_alias<set_offset, clear_offset, toggle_offset>*)
+    noexcept {
+    return is_alias_in_memory<Register, set_offset>::value
+           && is_alias_in_memory<Register, clear_offset>::value
+           && is_alias_in_memory<Register, toggle_offset>::value;
+}
+}    
+template <typename RegisterPack,
+          typename Backend = typename RegisterPack::backend>
+struct RegisterMemoryDevice {
+    using mem_device =    // NOLINT
+        typename Backend::template device<RegisterPack::pack_base,
+                                          RegisterPack::size_in_bytes>;
+};
+}    
+#endif    
+
+// Mask.h
+#ifndef CPPREG_MASK_H
+#define CPPREG_MASK_H
+namespace cppreg {
+template <typename Mask>
+constexpr Mask make_mask(const FieldWidth width) noexcept {
+    return (width == 0U)
+               ? static_cast<Mask>(0U)
+               : static_cast<Mask>(
+                   static_cast<Mask>(~static_cast<Mask>(0U))
+                   >> ((width >= std::numeric_limits<Mask>::digits)
+                           ? 0U
+                           : (std::numeric_limits<Mask>::digits - width)));
+}
+template <typename Mask>
+constexpr Mask make_shifted_mask(const FieldWidth width,
+                                 const FieldOffset offset) noexcept {
+    return (offset >= std::numeric_limits<Mask>::digits)
+               ? static_cast<Mask>(0U)
+               : static_cast<Mask>(make_mask<Mask>(width) << offset);
+}
+static_assert(make_mask<std::uint8_t>(0U) == 0x0U, "make_mask:: b8/0");
+static_assert(make_mask<std::uint8_t>(1U) == 0x1U, "make_mask:: b8/1");
+static_assert(make_mask<std::uint8_t>(7U) == 0x7FU, "make_mask:: b8/7");
+static_assert(make_mask<std::uint8_t>(8U) == 0xFFU, "make_mask:: b8/8");
+static_assert(make_mask<std::uint16_t>(0U) == 0x0U, "make_mask:: b16/0");
+static_assert(make_mask<std::uint16_t>(1U) == 0x1U, "make_mask:: b16/1");
+static_assert(make_mask<std::uint16_t>(15U) == 0x7FFFU, "make_mask:: b16/15");
+static_assert(make_mask<std::uint16_t>(16U) == 0xFFFFU, "make_mask:: b16/16");
+static_assert(make_mask<std::uint32_t>(0U) == 0x0U, "make_mask:: b32/0");
+static_assert(make_mask<std::uint32_t>(1U) == 0x1U, "make_mask:: b32/1");
+static_assert(make_mask<std::uint32_t>(31U) == 0x7FFFFFFFU,
+              "make_mask:: b32/31");
+static_assert(make_mask<std::uint32_t>(32U) == 0xFFFFFFFFU,
+              "make_mask:: b32/32");
+static_assert(make_mask<std::uint64_t>(0U) == 0x0U, "make_mask:: b64/0");
+static_assert(make_mask<std::uint64_t>(1U) == 0x1U, "make_mask:: b64/1");
+static_assert(make_mask<std::uint64_t>(33U) == 0x1FFFFFFFFU,
+              "make_mask:: b64/33");
+static_assert(make_mask<std::uint64_t>(63U) == 0x7FFFFFFFFFFFFFFFU,
+              "make_mask:: b64/63");
+static_assert(make_mask<std::uint64_t>(64U) == 0xFFFFFFFFFFFFFFFFU,
+              "make_mask:: b64/64");
+static_assert(make_shifted_mask<std::uint8_t>(1U, 7U) == 0x80U,
+              "make_shifted_mask:: b8/1/7");
+static_assert(make_shifted_mask<std::uint8_t>(4U, 6U) == 0xC0U,
+              "make_shifted_mask:: b8/4/6");
+static_assert(make_shifted_mask<std::uint16_t>(1U, 15U) == 0x8000U,
+              "make_shifted_mask:: b16/1/15");
+static_assert(make_shifted_mask<std::uint32_t>(1U, 31U) == 0x80000000U,
+              "make_shifted_mask:: b32/1/31");
+static_assert(make_shifted_mask<std::uint32_t>(8U, 8U) == 0xFF00U,
+              "make_shifted_mask:: b32/8/8");
+static_assert(make_shifted_mask<std::uint64_t>(1U, 63U)
+                  == 0x8000000000000000U,
+              "make_shifted_mask:: b64/1/63");
+static_assert(make_shifted_mask<std::uint64_t>(64U, 0U)
+                  == 0xFFFFFFFFFFFFFFFFU,
+              "make_shifted_mask:: b64/64/0");
+static_assert(make_shifted_mask<std::uint32_t>(1U, 32U) == 0x0U,
+              "make_shifted_mask:: b32/1/32");
+}    
+#endif    
+
+// ShadowValue.h
+#ifndef CPPREG_SHADOWVALUE_H
+#define CPPREG_SHADOWVALUE_H
+namespace cppreg {
+template <typename Register, bool use_shadow>
+struct Shadow : std::false_type {};
+template <typename Register>
+struct Shadow<Register, true> : std::true_type {
+    static typename Register::type shadow_value;
+};
+template <typename Register>
+typename Register::type Shadow<Register, true>::shadow_value = Register::reset;
+template <typename Register, bool use_shadow_read>
+struct ShadowRead : std::false_type {};
+template <typename Register>
+struct ShadowRead<Register, true> : std::true_type {};
+}    
+#endif    
+
+// RegisterValue.h
+#ifndef CPPREG_REGISTERVALUE_H
+#define CPPREG_REGISTERVALUE_H
+namespace cppreg {
+namespace internals {
+template <typename F, typename F::type value>
+struct field_match {    // NOLINT
+    using field = F;    // NOLINT
+    constexpr static auto mask = F::mask;
+    constexpr static auto expected =
+        static_cast<typename F::type>((value << F::offset) & F::mask);
+    static_assert(
+        check_overflow<typename F::type, value, (F::mask >> F::offset)>::
+            value,
+        "Field::eq<value>: value too large for the field");
+};
+template <typename Register, typename... Conditions>
+struct match_conditions {    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    constexpr static const type mask = 0;
+    constexpr static const type expected = 0;
+    constexpr static const bool from_register = true;
+    constexpr static const bool consistent = true;
+};
+template <typename Register, typename C, typename... Conditions>
+struct match_conditions<Register, C, Conditions...> {    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    using tail = match_conditions<Register, Conditions...>;    // NOLINT
+    constexpr static const type mask =
+        static_cast<type>(C::mask | tail::mask);
+    constexpr static const type expected =
+        static_cast<type>(C::expected | tail::expected);
+    constexpr static const bool from_register =
+        std::is_base_of<Register, typename C::field::parent_register>::value
+        && tail::from_register;
+    constexpr static const bool consistent =
+        ((C::expected ^ tail::expected) & C::mask & tail::mask) == 0
+        && tail::consistent;
+};
+}    
+template <typename Register>
+class RegisterValue {
+public:
+    using type = typename Register::type;    // NOLINT
+private:
+    type _value;    // NOLINT
+    template <typename F>
+    using is_field =    // NOLINT
+        std::is_base_of<Register, typename F::parent_register>;
+    template <typename F>
+    static void check_writable() noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        static_assert(!is_atomic_policy<typename F::policy>::value,
+                      "RegisterValue:: atomic fields are not supported");
+        static_assert(
+            !std::is_base_of<write_1_to_clear, typename F::policy>::value
+                && !std::is_base_of<write_1_to_set,
+                                    typename F::policy>::value,
+            "RegisterValue:: write-1-to-clear/set fields are not supported");
+        static_assert(
+            std::is_base_of<read_write, typename F::policy>::value
+                || std::is_base_of<write_only, typename F::policy>::value,
+            "RegisterValue:: field is not writable");
+    }
+    template <typename T>
+    using if_no_shadow_read =    // NOLINT
+        typename std::enable_if<!Register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_shadow_read =    // NOLINT
+        typename std::enable_if<Register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+public:
+    constexpr explicit RegisterValue(const type value) noexcept
+        : _value{value} {};
+    template <typename T = RegisterValue>
+    static T load(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        return T{Register::ro_mem_device()};
+    }
+    template <typename T = RegisterValue>
+    static T load(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        return T{Register::shadow::shadow_value};
+    }
+    constexpr type raw() const noexcept {
+        return _value;
+    }
+    template <typename F>
+    typename F::value_type read() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<typename F::value_type>(
+            static_cast<type>((_value & F::mask) >> F::offset));
+    }
+    template <typename F>
+    bool is_set() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<type>(_value & F::mask) == F::mask;
+    }
+    template <typename F>
+    bool is_clear() const noexcept {
+        static_assert(is_field<F>::value,
+                      "RegisterValue:: field is not from the same register");
+        return static_cast<type>(_value & F::mask) == type{0};
+    }
+    template <typename... Conditions>
+    bool matches() const noexcept {
+        using combined = internals::match_conditions<Register, Conditions...>;
+        static_assert(combined::from_register,
+                      "RegisterValue:: field is not from the same register");
+        static_assert(combined::consistent,
+                      "RegisterValue::matches:: contradictory conditions");
+        return static_cast<type>(_value & combined::mask)
+               == combined::expected;
+    }
+    template <typename F>
+    RegisterValue& write(const typename F::value_type value) noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(
+            (_value & static_cast<type>(~F::mask))
+            | (static_cast<type>(static_cast<type>(value) << F::offset)
+               & F::mask));
+        return *this;
+    }
+    template <typename F, typename F::value_type value>
+    RegisterValue& write() noexcept {
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "RegisterValue::write<value>: value too large for the field");
+        return write<F>(value);
+    }
+    template <typename F>
+    RegisterValue& set() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value | F::mask);
+        return *this;
+    }
+    template <typename F>
+    RegisterValue& clear() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value & static_cast<type>(~F::mask));
+        return *this;
+    }
+    template <typename F>
+    RegisterValue& toggle() noexcept {
+        check_writable<F>();
+        _value = static_cast<type>(_value ^ F::mask);
+        return *this;
+    }
+    template <typename Ordering = no_barrier, typename T = void>
+    void store(if_no_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::rw_mem_device() = _value;
+        Ordering::apply();
+    }
+    template <typename Ordering = no_barrier, typename T = void>
+    void store(if_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::shadow::shadow_value = _value;
+        Register::rw_mem_device() = _value;
+        Ordering::apply();
+    }
+};
+}    
+#endif    
+
+// MergeWrite.h
+#ifndef CPPREG_MERGEWRITE_H
+#define CPPREG_MERGEWRITE_H
+namespace cppreg {
+template <typename Register,
+          typename Register::type mask,
+          FieldOffset offset,
+          typename Register::type value,
+          bool atomic = false>
+class MergeWrite_tmpl {    // NOLINT
+private:
+    using base_type = typename Register::type;    // NOLINT
+    constexpr static auto _accumulated_value =    // NOLINT
+        base_type{(value << offset) & mask};
+    constexpr static auto _combined_mask = mask;    // NOLINT
+    constexpr static auto _from_reset_value =    // NOLINT
+        static_cast<base_type>(
+            (Register::reset & static_cast<base_type>(~_combined_mask))
+            | _accumulated_value);
+    template <typename F, base_type new_value>
+    using propagated =    // NOLINT
         MergeWrite_tmpl<Register,
                         (_combined_mask | F::mask),
                         FieldOffset{0},
                         (_accumulated_value
                          & static_cast<typename Register::type>(~F::mask))
-                            | ((new_value << F::offset) & F::mask)>;
+                            | ((new_value << F::offset) & F::mask),
+                        atomic || is_atomic_policy<typename F::policy>::value>;
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWriteConstant<typename Register::MMIO,
+                                        base_type,
+                                        _combined_mask,
+                                        FieldOffset{0},
+                                        _accumulated_value>,
+            RegisterWriteConstant<typename Register::MMIO,
+                                  base_type,
+                                  _combined_mask,
+                                  FieldOffset{0},
+                                  _accumulated_value>>::type;
     MergeWrite_tmpl() = default;
-    static_assert(!Register::shadow::value,
-                  "merge write is not available for shadow value register");
+    template <typename R,
+              typename R::type m,
+              FieldOffset o,
+              typename R::type v,
+              bool a>
+    friend class MergeWrite_tmpl;
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    static void store_from_reset() noexcept {
+        if (_from_reset_value != Register::reset) {
+            RegisterWriteConstant<typename Register::MMIO,
+                                  base_type,
+                                  type_mask<base_type>::value,
+                                  FieldOffset{0},
+                                  _from_reset_value>::
+                write(Register::rw_mem_device());
+        }
+    }
 public:
     static MergeWrite_tmpl create() noexcept {
         return {};
@@ -316,29 +1530,59 @@ public:
     MergeWrite_tmpl& operator=(const MergeWrite_tmpl&) = delete;
     MergeWrite_tmpl& operator=(MergeWrite_tmpl&&) = delete;
     MergeWrite_tmpl operator=(MergeWrite_tmpl) = delete;
-    void done() const&& noexcept {
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_no_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
         typename Register::MMIO& mmio_device = Register::rw_mem_device();
-        RegisterWriteConstant<typename Register::MMIO,
-                              typename Register::type,
+        writer::write(mmio_device);
+        Ordering::apply();
+    }
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
+        RegisterWriteConstant<base_type,
+                              base_type,
                               _combined_mask,
                               FieldOffset{0},
-                              _accumulated_value>::write(mmio_device);
+                              _accumulated_value>::
+            write(Register::shadow::shadow_value);
+        RegisterWrite<typename Register::MMIO,
+                      base_type,
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+        Ordering::apply();
     }
-    template <typename F, base_type field_value>
-    propagated<F, field_value> with() const&& noexcept {
+    template <typename Ordering = no_barrier, typename T = void>
+    void done_from_reset(if_no_shadow<T>* = nullptr) const&& noexcept {
+        store_from_reset();
+        Ordering::apply();
+    }
+    template <typename Ordering = no_barrier, typename T = void>
+    void done_from_reset(if_shadow<T>* = nullptr) const&& noexcept {
+        Register::shadow::shadow_value = _from_reset_value;
+        store_from_reset();
+        Ordering::apply();
+    }
+    template <typename F, typename F::value_type field_value>
+    propagated<F, static_cast<base_type>(field_value)> with() const&& noexcept {
         static_assert(
             std::is_same<typename F::parent_register, Register>::value,
             "MergeWrite_tmpl:: field is not from the same register");
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "MergeWrite_tmpl:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "MergeWrite_tmpl:: field is not writable");
         constexpr auto no_overflow =
             internals::check_overflow<typename Register::type,
-                                      field_value,
+                                      static_cast<base_type>(field_value),
                                       (F::mask >> F::offset)>::value;
         static_assert(no_overflow,
                       "MergeWrite_tmpl:: field overflow in with() call");
-        return propagated<F, field_value>{};
+        return propagated<F, static_cast<base_type>(field_value)>{};
     }
 };
-template <typename Register, typename Register::type mask>
+template <typename Register, typename Register::type mask, bool atomic = false>
 class MergeWrite {
 private:
     using base_type = typename Register::type;    // NOLINT
@@ -346,11 +1590,28 @@ private:
     constexpr static auto _combined_mask = mask;    // NOLINT
     template <typename F>
     using propagated =    // NOLINT
-        MergeWrite<Register, _combined_mask | F::mask>;
+        MergeWrite<Register,
+                   _combined_mask | F::mask,
+                   atomic || is_atomic_policy<typename F::policy>::value>;
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWrite<typename Register::MMIO,
+                                base_type,
+                                _combined_mask,
+                                FieldOffset{0}>,
+            RegisterWrite<typename Register::MMIO,
+                          base_type,
+                          _combined_mask,
+                          FieldOffset{0}>>::type;
     constexpr MergeWrite() : _accumulated_value{0} {};
     constexpr explicit MergeWrite(const base_type v) : _accumulated_value{v} {};
-    static_assert(!Register::shadow::value,
-                  "merge write is not available for shadow value register");
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
 public:
     constexpr static MergeWrite create(const base_type value) noexcept {
         return MergeWrite(value);
@@ -361,25 +1622,406 @@ public:
     MergeWrite(const MergeWrite&) = delete;
     MergeWrite& operator=(const MergeWrite&) = delete;
     MergeWrite& operator=(MergeWrite&&) = delete;
-    void done() const&& noexcept {
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_no_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
         typename Register::MMIO& mmio_device = Register::rw_mem_device();
+        writer::write(mmio_device, _accumulated_value);
+        Ordering::apply();
+    }
+    template <typename Ordering = no_barrier, typename T = void>
+    void done(if_shadow<T>* = nullptr) const&& noexcept {    // NOLINT
+        RegisterWrite<base_type, base_type, _combined_mask, FieldOffset{0}>::
+            write(Register::shadow::shadow_value, _accumulated_value);
         RegisterWrite<typename Register::MMIO,
                       base_type,
-                      _combined_mask,
-                      FieldOffset{0}>::write(mmio_device, _accumulated_value);
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+        Ordering::apply();
     }
     template <typename F>
-    propagated<F> with(const base_type value) const&& noexcept {
+    propagated<F> with(const typename F::value_type value) const&& noexcept {
         static_assert(
             std::is_same<typename F::parent_register, Register>::value,
             "field is not from the same register in merge_write");
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "MergeWrite:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "MergeWrite:: field is not writable");
         constexpr auto neg_mask = static_cast<base_type>(~F::mask);
-        const auto shifted_value = static_cast<base_type>(value << F::offset);
+        const auto shifted_value =
+            static_cast<base_type>(static_cast<base_type>(value) << F::offset);
         const auto lhs = static_cast<base_type>(_accumulated_value & neg_mask);
         const auto rhs = static_cast<base_type>(shifted_value & F::mask);
         return propagated<F>::create(static_cast<base_type>(lhs | rhs));
     }
 };
+namespace internals {
+template <typename Register,
+          typename Register::type mask,
+          typename Register::type value,
+          bool atomic = false>
+struct pack_write_entry {    // NOLINT
+    using reg = Register;    // NOLINT
+    constexpr static auto combined_mask = mask;
+    constexpr static auto accumulated_value = value;
+    constexpr static auto from_reset_value = static_cast<
+        typename Register::type>(
+        (Register::reset & static_cast<typename Register::type>(~mask))
+        | value);
+    constexpr static auto is_atomic = atomic;
+    using writer =    // NOLINT
+        typename std::conditional<
+            atomic,
+            AtomicRegisterWriteConstant<typename Register::MMIO,
+                                        typename Register::type,
+                                        mask,
+                                        FieldOffset{0},
+                                        value>,
+            RegisterWriteConstant<typename Register::MMIO,
+                                  typename Register::type,
+                                  mask,
+                                  FieldOffset{0},
+                                  value>>::type;
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    template <typename T = void>
+    static void write(if_no_shadow<T>* = nullptr) noexcept {    // NOLINT
+        writer::write(Register::rw_mem_device());
+    }
+    template <typename T = void>
+    static void write(if_shadow<T>* = nullptr) noexcept {    // NOLINT
+        using base_type = typename Register::type;
+        RegisterWriteConstant<base_type,
+                              base_type,
+                              combined_mask,
+                              FieldOffset{0},
+                              accumulated_value>::
+            write(Register::shadow::shadow_value);
+        RegisterWrite<typename Register::MMIO,
+                      base_type,
+                      type_mask<base_type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             Register::shadow::shadow_value);
+    }
+    template <typename T = void>
+    static void write_from_reset(if_no_shadow<T>* = nullptr) noexcept {
+        store_from_reset();
+    }
+    template <typename T = void>
+    static void write_from_reset(if_shadow<T>* = nullptr) noexcept {
+        Register::shadow::shadow_value = from_reset_value;
+        store_from_reset();
+    }
+    static void store_from_reset() noexcept {
+        if (from_reset_value != Register::reset) {
+            RegisterWriteConstant<typename Register::MMIO,
+                                  typename Register::type,
+                                  type_mask<typename Register::type>::value,
+                                  FieldOffset{0},
+                                  from_reset_value>::
+                write(Register::rw_mem_device());
+        }
+    }
+};
+template <typename F, typename F::type value>
+struct pack_write_field {    // NOLINT
+    using reg = typename F::parent_register;    // NOLINT
+    using entry =    // NOLINT
+        pack_write_entry<reg,
+                         F::mask,
+                         static_cast<typename F::type>((value << F::offset)
+                                                       & F::mask),
+                         is_atomic_policy<typename F::policy>::value>;
+    template <typename E>
+    using merged =    // NOLINT
+        pack_write_entry<reg,
+                         static_cast<typename F::type>(E::combined_mask
+                                                       | F::mask),
+                         static_cast<typename F::type>(
+                             (E::accumulated_value
+                              & static_cast<typename F::type>(~F::mask))
+                             | entry::accumulated_value),
+                         E::is_atomic || entry::is_atomic>;
+};
+template <typename... Entries>
+struct pack_write_list {};    // NOLINT
+template <typename Entry, typename List>
+struct pack_write_prepend;    // NOLINT
+template <typename Entry, typename... Entries>
+struct pack_write_prepend<Entry, pack_write_list<Entries...>> {
+    using type = pack_write_list<Entry, Entries...>;    // NOLINT
+};
+template <typename List, typename W>
+struct pack_write_insert;    // NOLINT
+template <typename W>
+struct pack_write_insert<pack_write_list<>, W> {
+    using type = pack_write_list<typename W::entry>;    // NOLINT
+};
+template <typename List, typename W, int order>
+struct pack_write_insert_impl;    // NOLINT
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, -1> {
+    using type = pack_write_list<typename W::entry, Head, Tail...>;    // NOLINT
+};
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, 0> {
+    using type =    // NOLINT
+        pack_write_list<typename W::template merged<Head>, Tail...>;
+};
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert_impl<pack_write_list<Head, Tail...>, W, 1> {
+    using type = typename pack_write_prepend<    // NOLINT
+        Head,
+        typename pack_write_insert<pack_write_list<Tail...>, W>::type>::type;
+};
+template <typename Head, typename... Tail, typename W>
+struct pack_write_insert<pack_write_list<Head, Tail...>, W>
+    : pack_write_insert_impl<
+          pack_write_list<Head, Tail...>,
+          W,
+          std::is_same<typename Head::reg, typename W::reg>::value
+              ? 0
+              : (W::reg::base_address < Head::reg::base_address ? -1 : 1)> {
+};
+}    
+template <typename RegisterPack, typename... Entries>
+class PackMergeWrite_tmpl {    // NOLINT
+private:
+    template <typename List>
+    struct rebind;    // NOLINT
+    template <typename... E>
+    struct rebind<internals::pack_write_list<E...>> {
+        using type = PackMergeWrite_tmpl<RegisterPack, E...>;    // NOLINT
+    };
+    template <typename F, typename F::type new_value>
+    using propagated =    // NOLINT
+        typename rebind<typename internals::pack_write_insert<
+            internals::pack_write_list<Entries...>,
+            internals::pack_write_field<F, new_value>>::type>::type;
+    PackMergeWrite_tmpl() = default;
+    template <typename P, typename... E>
+    friend class PackMergeWrite_tmpl;
+public:
+    static PackMergeWrite_tmpl create() noexcept {
+        return {};
+    }
+    ~PackMergeWrite_tmpl() = default;
+    PackMergeWrite_tmpl(PackMergeWrite_tmpl&&) noexcept = default;
+    PackMergeWrite_tmpl(const PackMergeWrite_tmpl&) = delete;
+    PackMergeWrite_tmpl& operator=(const PackMergeWrite_tmpl&) = delete;
+    PackMergeWrite_tmpl& operator=(PackMergeWrite_tmpl&&) = delete;
+    template <typename Ordering = no_barrier>
+    void done() const&& noexcept {
+        const int expand[] = {0, (Entries::write(), 0)...};
+        static_cast<void>(expand);
+        Ordering::apply();
+    }
+    template <typename Ordering = no_barrier>
+    void done_from_reset() const&& noexcept {
+        const int expand[] = {0, (Entries::write_from_reset(), 0)...};
+        static_cast<void>(expand);
+        Ordering::apply();
+    }
+    template <typename F, typename F::value_type field_value>
+    propagated<F, static_cast<typename F::type>(field_value)> with() const&&
+        noexcept {
+        static_assert(
+            internals::is_same_pack<typename F::parent_register::pack,
+                                    RegisterPack>::value,
+            "PackMergeWrite_tmpl:: field is not from the same pack");
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "PackMergeWrite_tmpl:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "PackMergeWrite_tmpl:: field is not writable");
+        constexpr auto no_overflow =
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(
+                                          field_value),
+                                      (F::mask >> F::offset)>::value;
+        static_assert(no_overflow,
+                      "PackMergeWrite_tmpl:: field overflow in with() call");
+        return propagated<F, static_cast<typename F::type>(field_value)>{};
+    }
+};
+}    
+#endif    
+
+// DeferredWrite.h
+#ifndef CPPREG_DEFERREDWRITE_H
+#define CPPREG_DEFERREDWRITE_H
+namespace cppreg {
+namespace internals {
+template <typename Register>
+struct deferred_write_entry {    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    type pending_value;
+    type pending_mask;
+    bool pending_read;
+    deferred_write_entry() noexcept
+        : pending_value{0}, pending_mask{0}, pending_read{false} {};
+    void update(const type mask,
+                const type value,
+                const bool write_only) noexcept {
+        pending_value = static_cast<type>(
+            (pending_value & static_cast<type>(~mask)) | (value & mask));
+        pending_mask = static_cast<type>(pending_mask | mask);
+        pending_read = pending_read || !write_only;
+    }
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    template <typename T = void>
+    void merge(if_no_shadow<T>* = nullptr) noexcept {    // NOLINT
+        if (pending_read && (pending_mask != type_mask<type>::value)) {
+            const type current = Register::ro_mem_device();
+            pending_value = static_cast<type>(
+                (current & static_cast<type>(~pending_mask)) | pending_value);
+        }
+    }
+    template <typename T = void>
+    void merge(if_shadow<T>* = nullptr) noexcept {    // NOLINT
+        if (pending_mask != type{0}) {
+            Register::shadow::shadow_value = static_cast<type>(
+                (Register::shadow::shadow_value
+                 & static_cast<type>(~pending_mask))
+                | pending_value);
+            pending_value = Register::shadow::shadow_value;
+        }
+    }
+    void store() noexcept {
+        if (pending_mask != type{0}) {
+            RegisterWrite<typename Register::MMIO,
+                          type,
+                          type_mask<type>::value,
+                          FieldOffset{0}>::write(Register::rw_mem_device(),
+                                                 pending_value);
+            discard();
+        }
+    }
+    bool is_pending() const noexcept {
+        return pending_mask != type{0};
+    }
+    void discard() noexcept {
+        pending_value = type{0};
+        pending_mask = type{0};
+        pending_read = false;
+    }
+};
+}    
+template <typename RegisterPack, typename... Registers>
+class DeferredWrite    // NOLINT
+    : private internals::deferred_write_entry<Registers>... {
+private:
+    template <typename F>
+    internals::deferred_write_entry<typename F::parent_register>&
+    entry() noexcept {
+        static_assert(
+            std::is_base_of<
+                internals::deferred_write_entry<typename F::parent_register>,
+                DeferredWrite>::value,
+            "DeferredWrite:: field register is not in the registers list");
+        static_assert(!is_atomic_policy<typename F::policy>::value,
+                      "DeferredWrite:: atomic fields are not supported");
+        static_assert(
+            !std::is_base_of<write_1_to_clear, typename F::policy>::value
+                && !std::is_base_of<write_1_to_set,
+                                    typename F::policy>::value,
+            "DeferredWrite:: write-1-to-clear/set fields are not supported");
+        static_assert(
+            std::is_base_of<read_write, typename F::policy>::value
+                || std::is_base_of<write_only, typename F::policy>::value,
+            "DeferredWrite:: field is not writable");
+        return *this;
+    }
+    template <typename F>
+    using is_write_only =    // NOLINT
+        std::is_base_of<write_only, typename F::policy>;
+    template <typename F>
+    static typename F::type shifted(const typename F::type value) noexcept {
+        return static_cast<typename F::type>(
+            static_cast<typename F::type>(value << F::offset) & F::mask);
+    }
+public:
+    DeferredWrite() = default;
+    template <typename F>
+    DeferredWrite& write(const typename F::value_type value) noexcept {
+        entry<F>().update(F::mask,
+                          shifted<F>(static_cast<typename F::type>(value)),
+                          is_write_only<F>::value);
+        return *this;
+    }
+    template <typename F, typename F::value_type value>
+    DeferredWrite& write() noexcept {
+        static_assert(
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "DeferredWrite::write<value>: value too large for the field");
+        return write<F>(value);
+    }
+    template <typename F>
+    DeferredWrite& set() noexcept {
+        entry<F>().update(F::mask, F::mask, is_write_only<F>::value);
+        return *this;
+    }
+    template <typename F>
+    DeferredWrite& clear() noexcept {
+        entry<F>().update(
+            F::mask, typename F::type{0}, is_write_only<F>::value);
+        return *this;
+    }
+    bool pending() const noexcept {
+        bool result = false;
+        const int expand[] = {
+            0,
+            (result = result
+                      || static_cast<const internals::deferred_write_entry<
+                          Registers>&>(*this)
+                             .is_pending(),
+             0)...};
+        static_cast<void>(expand);
+        return result;
+    }
+    template <typename Ordering = no_barrier>
+    void flush() noexcept {
+        const int merge_expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .merge(),
+             0)...};
+        const int store_expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .store(),
+             0)...};
+        static_cast<void>(merge_expand);
+        static_cast<void>(store_expand);
+        Ordering::apply();
+    }
+    void discard() noexcept {
+        const int expand[] = {
+            0,
+            (static_cast<internals::deferred_write_entry<Registers>&>(*this)
+                 .discard(),
+             0)...};
+        static_cast<void>(expand);
+    }
+    static_assert(
+        internals::is_pack_registers<RegisterPack, Registers...>::value,
+        "DeferredWrite:: register is not from the same pack");
+};
 }    
 #endif    
 
@@ -390,133 +2032,1346 @@ namespace cppreg {
 template <Address reg_address,
           RegBitSize reg_size,
           typename TypeTraits<reg_size>::type reset_value = 0x0,
-          bool use_shadow = false>
+          bool use_shadow = false,
+          bool use_shadow_read = false>
 struct Register {
     using type = typename TypeTraits<reg_size>::type;    // NOLINT
-    using MMIO = volatile type;
     using shadow = Shadow<Register, use_shadow>;    // NOLINT
+    using shadow_read = ShadowRead<Register, use_shadow_read>;    // NOLINT
     constexpr static auto base_address = reg_address;
     constexpr static auto size = TypeTraits<reg_size>::bit_size;
     constexpr static auto reset = reset_value;
     using pack = RegisterPack<base_address, size / one_byte>;    // NOLINT
+    using MMIO = typename std::remove_reference<    // NOLINT
+        decltype(RegisterMemoryDevice<pack>::mem_device::template rw_memory<
+                 reg_size,
+                 0>())>::type;
     static MMIO& rw_mem_device() {
         using MemDevice = typename RegisterMemoryDevice<pack>::mem_device;
         return MemDevice::template rw_memory<reg_size, 0>();
     }
-    static const MMIO& ro_mem_device() {
-        using MemDevice = typename RegisterMemoryDevice<pack>::mem_device;
-        return MemDevice::template ro_memory<reg_size, 0>();
+    static const MMIO& ro_mem_device() {
+        using MemDevice = typename RegisterMemoryDevice<pack>::mem_device;
+        return MemDevice::template ro_memory<reg_size, 0>();
+    }
+    static void resync() noexcept {
+        static_assert(shadow_read::value,
+                      "Register::resync:: shadow read is not enabled");
+        shadow::shadow_value = ro_mem_device();
+    }
+    static RegisterValue<Register> read_value() noexcept {
+        return RegisterValue<Register>::load();
+    }
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+    template <typename F,
+              typename T =
+                  MergeWrite<typename F::parent_register,
+                             F::mask,
+                             is_atomic_policy<typename F::policy>::value>>
+    static T merge_write(const typename F::value_type value) noexcept {
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "Register::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "Register::merge_write:: field is not writable");
+        const auto lhs = static_cast<type>(static_cast<type>(value)
+                                           << F::offset);
+        return T::create(static_cast<type>(lhs & F::mask));
+    }
+    template <typename F,
+              typename F::value_type value,
+              typename T = MergeWrite_tmpl<
+                  typename F::parent_register,
+                  F::mask,
+                  F::offset,
+                  static_cast<type>(value),
+                  is_atomic_policy<typename F::policy>::value>>
+    static T merge_write() noexcept {
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "Register::merge_write<value>:: value too large for the field");
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "Register::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "Register::merge_write:: field is not writable");
+        return T::create();
+    }
+    static_assert(size != 0, "Register:: register definition with zero size");
+    static_assert(use_shadow || !use_shadow_read,
+                  "Register:: shadow read requires shadow value to be enabled");
+    static_assert(internals::is_aligned<reg_address,
+                                        TypeTraits<reg_size>::byte_size>::value,
+                  "Register:: address is mis-aligned for register type");
+};
+}    
+#endif    
+
+// BusRegister.h
+#ifndef CPPREG_BUSREGISTER_H
+#define CPPREG_BUSREGISTER_H
+namespace cppreg {
+template <RegBitSize bus_size = RegBitSize::b32, bool exclusive_words = false>
+struct bus_access {    // NOLINT
+    constexpr static const auto size = bus_size;
+    constexpr static const bool exclusive = exclusive_words;
+};
+namespace internals {
+template <typename Device,
+          typename T,
+          typename Bus,
+          std::size_t first_offset,
+          std::size_t shift,
+          std::size_t width,
+          std::size_t index,
+          std::size_t n_words>
+struct bus_words {    // NOLINT
+    using word_type = typename TypeTraits<Bus::size>::type;    // NOLINT
+    constexpr static const std::size_t word_bits =
+        TypeTraits<Bus::size>::bit_size;
+    constexpr static const std::size_t word_offset =
+        first_offset + (index * TypeTraits<Bus::size>::byte_size);
+    constexpr static const std::size_t right = (index == 0) ? shift : 0;
+    constexpr static const std::size_t left =
+        (index == 0) ? 0 : (index * word_bits) - shift;
+    constexpr static const std::size_t end =
+        ((shift + width - (index * word_bits)) < word_bits)
+            ? (shift + width - (index * word_bits))
+            : word_bits;
+    constexpr static const word_type mask =
+        make_shifted_mask<word_type>(static_cast<FieldWidth>(end - right),
+                                     static_cast<FieldOffset>(right));
+    using next =    // NOLINT
+        bus_words<Device,
+                  T,
+                  Bus,
+                  first_offset,
+                  shift,
+                  width,
+                  index + 1,
+                  n_words>;
+    template <T value_mask>
+    using word_mask =    // NOLINT
+        std::integral_constant<
+            word_type,
+            static_cast<word_type>(
+                static_cast<word_type>(static_cast<T>(
+                    static_cast<T>(value_mask << right) >> left))
+                & mask)>;
+    template <T value_mask>
+    static T read() noexcept {
+        return static_cast<T>(
+            ((word_mask<value_mask>::value == word_type{0}) ? T{0}
+                                                             : read_word())
+            | next::template read<value_mask>());
+    }
+    template <T value_mask>
+    static void write(const T value) noexcept {
+        constexpr auto written = word_mask<value_mask>::value;
+        const auto bits = static_cast<word_type>(
+            static_cast<word_type>(
+                static_cast<T>(static_cast<T>(value << right) >> left))
+            & written);
+        if (written == word_type{0}) {
+        } else if ((written == type_mask<word_type>::value)
+                   || (Bus::exclusive && (written == mask))) {
+            Device::template rw_memory<Bus::size, word_offset>() = bits;
+        } else {
+            const auto word = static_cast<word_type>(
+                Device::template ro_memory<Bus::size, word_offset>());
+            Device::template rw_memory<Bus::size, word_offset>() =
+                static_cast<word_type>(
+                    (word & static_cast<word_type>(~written)) | bits);
+        }
+        next::template write<value_mask>(value);
+    }
+private:
+    static T read_word() noexcept {
+        const auto word = static_cast<word_type>(
+            Device::template ro_memory<Bus::size, word_offset>());
+        return static_cast<T>(
+            static_cast<T>(static_cast<T>(word) >> right) << left);
+    }
+};
+template <typename Device,
+          typename T,
+          typename Bus,
+          std::size_t first_offset,
+          std::size_t shift,
+          std::size_t width,
+          std::size_t n_words>
+struct bus_words<Device,
+                 T,
+                 Bus,
+                 first_offset,
+                 shift,
+                 width,
+                 n_words,
+                 n_words> {    // NOLINT
+    template <T>
+    static T read() noexcept {
+        return T{0};
+    }
+    template <T>
+    static void write(const T) noexcept {}    // NOLINT
+};
+}    
+template <typename Device,
+          std::uint8_t width,
+          std::size_t byte_offset,
+          typename Bus>
+class BusAccessRegister {
+public:
+    using type = typename WidthTraits<width>::type;    // NOLINT
+    constexpr static const Address address = Device::base_address + byte_offset;
+    constexpr static const std::size_t word_bytes =
+        TypeTraits<Bus::size>::byte_size;
+    constexpr static const std::size_t shift =
+        (address % word_bytes) * one_byte;
+    constexpr static const std::size_t first_offset =
+        byte_offset - (address % word_bytes);
+    constexpr static const std::size_t n_words =
+        (shift + width + TypeTraits<Bus::size>::bit_size - 1)
+        / TypeTraits<Bus::size>::bit_size;
+private:
+    using wide_type =    // NOLINT
+        typename std::conditional<(sizeof(type)
+                                   > sizeof(typename TypeTraits<
+                                            Bus::size>::type)),
+                                  type,
+                                  typename TypeTraits<Bus::size>::type>::type;
+    using words =    // NOLINT
+        internals::bus_words<Device,
+                             wide_type,
+                             Bus,
+                             first_offset,
+                             shift,
+                             width,
+                             0,
+                             n_words>;
+    constexpr static const type width_mask =
+        make_mask<type>(static_cast<FieldWidth>(width));
+    BusAccessRegister() = default;
+public:
+    BusAccessRegister(const BusAccessRegister&) = delete;
+    BusAccessRegister& operator=(const BusAccessRegister&) = delete;
+    static BusAccessRegister& instance() noexcept {
+        static BusAccessRegister reg;
+        return reg;
+    }
+    operator type() const noexcept {    // NOLINT
+        return read<width_mask>();
+    }
+    BusAccessRegister& operator=(const type value) noexcept {
+        write<width_mask>(value);
+        return *this;
+    }
+    template <type value_mask>
+    type read() const noexcept {
+        return static_cast<type>(
+            static_cast<type>(
+                words::template read<static_cast<wide_type>(value_mask)>())
+            & value_mask & width_mask);
+    }
+    template <type value_mask>
+    void write(const type value) noexcept {
+        words::template write<static_cast<wide_type>(value_mask & width_mask)>(
+            static_cast<wide_type>(value));
+    }
+    static_assert(internals::is_aligned<Device::base_address,
+                                        word_bytes>::value,
+                  "BusAccessRegister:: device address is mis-aligned for "
+                  "bus accesses");
+};
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          std::ptrdiff_t byte_offset>
+struct RegisterAlias<BusAccessRegister<Device, width, reg_offset, Bus>,
+                     byte_offset> {
+    using alias_type =    // NOLINT
+        BusAccessRegister<Device,
+                          width,
+                          static_cast<std::size_t>(
+                              static_cast<std::ptrdiff_t>(reg_offset)
+                              + byte_offset),
+                          Bus>;
+    static alias_type& get(
+        BusAccessRegister<Device, width, reg_offset, Bus>&) noexcept {
+        return alias_type::instance();
+    }
+};
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset>
+struct RegisterRead<BusAccessRegister<Device, width, reg_offset, Bus>,
+                    T,
+                    mask,
+                    offset> {
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+    static T read(const MMIO& mmio_device) noexcept {
+        return static_cast<T>(
+            static_cast<T>(mmio_device.template read<mask>()) >> offset);
+    }
+};
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset>
+struct RegisterWrite<BusAccessRegister<Device, width, reg_offset, Bus>,
+                     T,
+                     mask,
+                     offset> {
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+    static void write(MMIO& mmio_device, T value) noexcept {
+        mmio_device.template write<mask>(
+            static_cast<T>(static_cast<T>(value << offset) & mask));
+    }
+};
+template <typename Device,
+          std::uint8_t width,
+          std::size_t reg_offset,
+          typename Bus,
+          typename T,
+          T mask,
+          FieldOffset offset,
+          T value>
+struct RegisterWriteConstant<
+    BusAccessRegister<Device, width, reg_offset, Bus>,
+    T,
+    mask,
+    offset,
+    value> {
+    using MMIO = BusAccessRegister<Device, width, reg_offset, Bus>;    // NOLINT
+    static void write(MMIO& mmio_device) noexcept {
+        RegisterWrite<MMIO, T, mask, offset>::write(mmio_device, value);
+    }
+};
+template <typename RegisterPack,
+          std::uint8_t reg_width,
+          std::uint32_t bit_offset,
+          typename Bus = bus_access<>,
+          typename WidthTraits<reg_width>::type reset_value = 0x0,
+          bool use_shadow = false,
+          bool use_shadow_read = false>
+struct BusRegister {
+    using pack = RegisterPack;    // NOLINT
+    using bus = Bus;    // NOLINT
+    using type = typename WidthTraits<reg_width>::type;    // NOLINT
+    using shadow = Shadow<BusRegister, use_shadow>;    // NOLINT
+    using shadow_read = ShadowRead<BusRegister, use_shadow_read>;    // NOLINT
+    constexpr static const Address base_address =
+        RegisterPack::pack_base + (bit_offset / one_byte);
+    constexpr static const auto size = WidthTraits<reg_width>::bit_size;
+    constexpr static const auto reset = reset_value;
+    using MMIO =    // NOLINT
+        BusAccessRegister<
+            typename RegisterMemoryDevice<RegisterPack>::mem_device,
+            reg_width,
+            (bit_offset / one_byte),
+            Bus>;
+    static MMIO& rw_mem_device() noexcept {
+        return MMIO::instance();
+    }
+    static const MMIO& ro_mem_device() noexcept {
+        return MMIO::instance();
+    }
+    static void resync() noexcept {
+        static_assert(shadow_read::value,
+                      "BusRegister::resync:: shadow read is not enabled");
+        shadow::shadow_value = ro_mem_device();
+    }
+    static RegisterValue<BusRegister> read_value() noexcept {
+        return RegisterValue<BusRegister>::load();
+    }
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+    template <typename F,
+              typename T =
+                  MergeWrite<typename F::parent_register,
+                             F::mask,
+                             is_atomic_policy<typename F::policy>::value>>
+    static T merge_write(const typename F::value_type value) noexcept {
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: field is not writable");
+        const auto lhs = static_cast<type>(static_cast<type>(value)
+                                           << F::offset);
+        return T::create(static_cast<type>(lhs & F::mask));
+    }
+    template <typename F,
+              typename F::value_type value,
+              typename T = MergeWrite_tmpl<
+                  typename F::parent_register,
+                  F::mask,
+                  F::offset,
+                  static_cast<type>(value),
+                  is_atomic_policy<typename F::policy>::value>>
+    static T merge_write() noexcept {
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "BusRegister::merge_write<value>:: value too large for the field");
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: write-1-to-clear/set "
+                      "fields are not supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "BusRegister::merge_write:: field is not writable");
+        return T::create();
+    }
+    static_assert(use_shadow || !use_shadow_read,
+                  "BusRegister:: shadow read requires shadow value to be "
+                  "enabled");
+    static_assert((bit_offset % one_byte) == 0,
+                  "BusRegister:: offset is not a multiple of 8 bits");
+    static_assert((bit_offset / one_byte) + WidthTraits<reg_width>::byte_size
+                      <= RegisterPack::size_in_bytes,
+                  "BusRegister:: register is overflowing the pack");
+    static_assert(MMIO::first_offset + (MMIO::n_words * MMIO::word_bytes)
+                      <= RegisterPack::size_in_bytes,
+                  "BusRegister:: bus words are overflowing the pack");
+};
+}    
+#endif    
+
+// RegisterPack.h
+#ifndef CPPREG_REGISTERPACK_H
+#define CPPREG_REGISTERPACK_H
+namespace cppreg {
+template <typename RegisterPack,
+          RegBitSize reg_size,
+          std::uint32_t bit_offset,
+          typename TypeTraits<reg_size>::type reset_value = 0x0,
+          bool use_shadow = false,
+          bool use_shadow_read = false>
+struct PackedRegister
+    : Register<RegisterPack::pack_base + (bit_offset / one_byte),
+               reg_size,
+               reset_value,
+               use_shadow,
+               use_shadow_read> {
+    using pack = RegisterPack;    // NOLINT
+    using base_reg =    // NOLINT
+        Register<RegisterPack::pack_base + (bit_offset / one_byte),
+                 reg_size,
+                 reset_value,
+                 use_shadow,
+                 use_shadow_read>;
+    using MMIO = typename std::remove_reference<    // NOLINT
+        decltype(RegisterMemoryDevice<RegisterPack>::mem_device::
+                     template rw_memory<reg_size,
+                                        (bit_offset / one_byte)>())>::type;
+    static MMIO& rw_mem_device() noexcept {
+        using MemDevice =
+            typename RegisterMemoryDevice<RegisterPack>::mem_device;
+        return MemDevice::template rw_memory<reg_size,
+                                             (bit_offset / one_byte)>();
+    }
+    static const MMIO& ro_mem_device() noexcept {
+        using MemDevice =
+            typename RegisterMemoryDevice<RegisterPack>::mem_device;
+        return MemDevice::template ro_memory<reg_size,
+                                             (bit_offset / one_byte)>();
+    }
+    static void resync() noexcept {
+        static_assert(base_reg::shadow_read::value,
+                      "PackedRegister::resync:: shadow read is not enabled");
+        base_reg::shadow::shadow_value = ro_mem_device();
+    }
+    static RegisterValue<PackedRegister> read_value() noexcept {
+        return RegisterValue<PackedRegister>::load();
+    }
+    template <typename... Conditions>
+    static bool matches() noexcept {
+        return read_value().template matches<Conditions...>();
+    }
+    static_assert(TypeTraits<reg_size>::byte_size + (bit_offset / one_byte)
+                      <= RegisterPack::size_in_bytes,
+                  "PackRegister:: packed register is overflowing the pack");
+    static_assert(
+        internals::is_aligned<RegisterPack::pack_base,
+                              TypeTraits<reg_size>::byte_size>::value,
+        "PackedRegister:: pack base address is mis-aligned for register type");
+    static_assert(
+        internals::is_aligned<RegisterPack::pack_base + (bit_offset / one_byte),
+                              TypeTraits<reg_size>::byte_size>::value,
+        "PackedRegister:: offset address is mis-aligned for register type");
+};
+namespace internals {
+template <typename F, typename G, typename H, std::size_t index>
+struct is_strided_field    // NOLINT
+    : std::integral_constant<
+          bool,
+          std::is_same<typename H::type, typename F::type>::value
+              && std::is_same<typename H::policy, typename F::policy>::value
+              && std::is_same<typename H::MMIO,
+                              volatile typename F::type>::value
+              && std::is_same<typename RegisterMemoryDevice<
+                                  typename H::parent_register::pack>::
+                                  mem_device,
+                              typename RegisterMemoryDevice<
+                                  typename F::parent_register::pack>::
+                                  mem_device>::value
+              && (H::mask == F::mask)
+              && !H::parent_register::shadow::value
+              && !H::parent_register::shadow_read::value
+              && (G::parent_register::base_address
+                  >= F::parent_register::base_address)
+              && (H::parent_register::base_address
+                  == F::parent_register::base_address
+                         + (index
+                            * (G::parent_register::base_address
+                               - F::parent_register::base_address)))> {};
+template <typename Tuple, std::size_t index, std::size_t n_elems>
+struct is_strided_pack    // NOLINT
+    : std::integral_constant<
+          bool,
+          is_strided_field<
+              typename std::tuple_element<0, Tuple>::type,
+              typename std::tuple_element<(n_elems > 1) ? 1 : 0, Tuple>::type,
+              typename std::tuple_element<index, Tuple>::type,
+              index>::value
+              && is_strided_pack<Tuple, index + 1, n_elems>::value> {};
+template <typename Tuple, std::size_t n_elems>
+struct is_strided_pack<Tuple, n_elems, n_elems> : std::true_type {};
+}    
+template <typename... T>
+struct PackIndexing {
+    using tuple_t = typename std::tuple<T...>;    // NOLINT
+    constexpr static const std::size_t n_elems =
+        std::tuple_size<tuple_t>::value;
+    template <std::size_t n>
+    using elem = typename std::tuple_element<n, tuple_t>::type;    // NOLINT
+private:
+    template <typename Tuple>
+    using is_strided =    // NOLINT
+        internals::is_strided_pack<Tuple, 0, std::tuple_size<Tuple>::value>;
+    template <typename Tuple>
+    using value_t =    // NOLINT
+        typename std::tuple_element<0, Tuple>::type::type;
+    template <std::size_t... n>
+    struct indices {};    // NOLINT
+    template <std::size_t k, std::size_t... n>
+    struct make_indices : make_indices<k - 1, k - 1, n...> {};    // NOLINT
+    template <std::size_t... n>
+    struct make_indices<0, n...> {    // NOLINT
+        using type = indices<n...>;    // NOLINT
+    };
+    template <typename Func, typename R, std::size_t... n>
+    static R dispatch_impl(const std::size_t index, indices<n...>) noexcept {
+        using entry_t = R (*)();
+        static const entry_t table[] = {&dispatch_entry<Func, R, n>...};
+        return table[index]();
+    }
+    template <typename Func, typename R, std::size_t n>
+    static R dispatch_entry() noexcept {
+        return Func().template operator()<n>();
+    }
+    template <typename Op, typename R, std::size_t... n>
+    static R dispatch_impl(const std::size_t index,
+                           Op& f,    // NOLINT
+                           indices<n...>) noexcept {
+        using entry_t = R (*)(Op&);
+        static const entry_t table[] = {&dispatch_entry<Op, R, n>...};
+        return table[index](f);
+    }
+    template <typename Op, typename R, std::size_t n>
+    static R dispatch_entry(Op& f) noexcept {    // NOLINT
+        return f(std::integral_constant<std::size_t, n>{});
+    }
+    template <typename F>
+    static typename F::type read_entry() noexcept {
+        return F::read();
+    }
+    template <typename F>
+    static void write_entry(const typename F::type value) noexcept {
+        F::write(value);
+    }
+    template <typename F>
+    static typename F::MMIO& strided_memory(const std::size_t index) noexcept {
+        constexpr auto stride =
+            elem<(n_elems > 1) ? 1 : 0>::parent_register::base_address
+            - F::parent_register::base_address;
+        return *(reinterpret_cast<typename F::MMIO*>(    // NOLINT
+            reinterpret_cast<std::uintptr_t>(
+                &F::parent_register::rw_mem_device())
+            + (index * stride)));
+    }
+public:
+    template <typename Func,
+              typename R = decltype(Func().template operator()<0>())>
+    static R dispatch(const std::size_t index) noexcept {
+        return dispatch_impl<Func, R>(
+            index, typename make_indices<n_elems>::type{});
+    }
+    template <typename Op,
+              typename R = decltype(std::declval<Op&>()(
+                  std::integral_constant<std::size_t, 0>{}))>
+    static R dispatch(const std::size_t index, Op&& f) noexcept {
+        return dispatch_impl<typename std::remove_reference<Op>::type, R>(
+            index, f, typename make_indices<n_elems>::type{});
+    }
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<!is_strided<Tuple>::value,
+                                   value_t<Tuple>>::type
+    read(const std::size_t index) noexcept {
+        using entry_t = value_t<Tuple> (*)();
+        static const entry_t table[] = {&read_entry<T>...};
+        return table[index]();
+    }
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<is_strided<Tuple>::value,
+                                   value_t<Tuple>>::type
+    read(const std::size_t index) noexcept {
+        using F = elem<0>;
+        return F::policy::template read<typename F::MMIO,
+                                        typename F::type,
+                                        F::mask,
+                                        F::offset>(strided_memory<F>(index));
+    }
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<!is_strided<Tuple>::value>::type write(
+        const std::size_t index,
+        const value_t<Tuple> value) noexcept {
+        using entry_t = void (*)(value_t<Tuple>);
+        static const entry_t table[] = {&write_entry<T>...};
+        table[index](value);
+    }
+    template <typename Tuple = tuple_t>
+    static typename std::enable_if<is_strided<Tuple>::value>::type write(
+        const std::size_t index,
+        const value_t<Tuple> value) noexcept {
+        using F = elem<0>;
+        F::policy::template write<typename F::MMIO,
+                                  typename F::type,
+                                  F::mask,
+                                  F::offset>(strided_memory<F>(index), value);
+    }
+};
+namespace internals {
+#if __cplusplus >= 201703L
+template <std::size_t start, std::size_t stride, bool reverse, typename Seq>
+struct loop_unroll;    // NOLINT
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t... k>
+struct loop_unroll<start, stride, reverse, std::index_sequence<k...>> {
+    constexpr static std::size_t index(const std::size_t counter) noexcept {
+        return start
+               + (stride * (reverse ? (sizeof...(k) - 1U - counter) : counter));
+    }
+    template <typename Func>
+    static void apply() noexcept {
+        (Func().template operator()<index(k)>(), ...);
+    }
+    template <typename Op>
+    static void apply(Op& f) noexcept {    // NOLINT
+        (f(std::integral_constant<std::size_t, index(k)>{}), ...);
+    }
+};
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+using loop_impl =    // NOLINT
+    loop_unroll<start, stride, reverse, std::make_index_sequence<n>>;
+#else
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+struct loop_recursive {    // NOLINT
+    using next =    // NOLINT
+        loop_recursive<start + stride, stride, reverse, n - 1U>;
+    template <typename Func>
+    static void apply() noexcept {
+        if (!reverse) {
+            Func().template operator()<start>();
+        }
+        next::template apply<Func>();
+        if (reverse) {
+            Func().template operator()<start>();
+        }
+    }
+    template <typename Op>
+    static void apply(Op& f) noexcept {    // NOLINT
+        if (!reverse) {
+            f(std::integral_constant<std::size_t, start>{});
+        }
+        next::apply(f);
+        if (reverse) {
+            f(std::integral_constant<std::size_t, start>{});
+        }
+    }
+};
+template <std::size_t start, std::size_t stride, bool reverse>
+struct loop_recursive<start, stride, reverse, 0U> {
+    template <typename Func>
+    static void apply() noexcept {}
+    template <typename Op>
+    static void apply(Op&) noexcept {}    // NOLINT
+};
+template <std::size_t start, std::size_t stride, bool reverse, std::size_t n>
+using loop_impl = loop_recursive<start, stride, reverse, n>;    // NOLINT
+#endif    
+}    
+template <std::size_t start, std::size_t end>
+struct for_loop {    // NOLINT
+private:
+    template <std::size_t stride, bool reverse>
+    using impl =    // NOLINT
+        internals::loop_impl<start,
+                             stride,
+                             reverse,
+                             ((end > start) && (stride != 0U))
+                                 ? ((end - start + stride - 1U) / stride)
+                                 : 0U>;
+public:
+    template <typename Func>
+    static void apply() noexcept {
+        impl<1U, false>::template apply<Func>();
+    }
+    template <typename Func>
+    static void apply_reverse() noexcept {
+        impl<1U, true>::template apply<Func>();
+    }
+    template <std::size_t stride, typename Func>
+    static void apply_strided() noexcept {
+        static_assert(stride != 0U, "for_loop:: stride cannot be zero");
+        impl<stride, false>::template apply<Func>();
+    }
+#if __cplusplus >= 201402L
+    template <typename Op>
+    static void apply(Op&& f) noexcept {
+        impl<1U, false>::apply(f);
+    }
+    template <typename Op>
+    static void apply_reverse(Op&& f) noexcept {
+        impl<1U, true>::apply(f);
+    }
+    template <std::size_t stride, typename Op>
+    static void apply_strided(Op&& f) noexcept {
+        static_assert(stride != 0U, "for_loop:: stride cannot be zero");
+        impl<stride, false>::apply(f);
+    }
+#endif    
+};
+template <typename IndexedPack>
+struct pack_loop : for_loop<0, IndexedPack::n_elems> {};    // NOLINT
+}    
+#endif    
+
+// PackSnapshot.h
+#ifndef CPPREG_PACKSNAPSHOT_H
+#define CPPREG_PACKSNAPSHOT_H
+namespace cppreg {
+template <typename RegisterPack, RegBitSize max_access_size = RegBitSize::b32>
+class PackSnapshot {
+public:
+    constexpr static const auto access_size =
+        internals::widest_access<RegisterPack::pack_base,
+                                 RegisterPack::size_in_bytes,
+                                 max_access_size>::value;
+    using access_type = typename TypeTraits<access_size>::type;    // NOLINT
+    constexpr static const std::size_t n_accesses =
+        RegisterPack::size_in_bytes / TypeTraits<access_size>::byte_size;
+    using storage_type = std::array<access_type, n_accesses>;    // NOLINT
+private:
+    using mem_device =    // NOLINT
+        typename RegisterMemoryDevice<RegisterPack>::mem_device;
+    storage_type _storage;    // NOLINT
+    template <std::size_t index, std::size_t end>
+    struct copy {    // NOLINT
+        static void apply(storage_type& storage) noexcept {
+            storage[index] = mem_device::template ro_memory<
+                access_size,
+                index * TypeTraits<access_size>::byte_size>();
+            copy<index + 1, end>::apply(storage);
+        }
+    };
+    template <std::size_t end>
+    struct copy<end, end> {    // NOLINT
+        static void apply(storage_type&) noexcept {}    // NOLINT
+    };
+    template <typename R>
+    struct register_offset    // NOLINT
+        : std::integral_constant<
+              std::size_t,
+              static_cast<std::size_t>(R::base_address
+                                       - RegisterPack::pack_base)> {
+        static_assert(
+            internals::is_same_pack<typename R::pack, RegisterPack>::value,
+            "PackSnapshot:: register is not from the same pack");
+    };
+    template <typename R>
+    static std::true_type is_bus_register(const typename R::bus*);
+    template <typename R>
+    static std::false_type is_bus_register(...);
+    template <typename T>
+    T load(const std::size_t byte_offset) const noexcept {
+        auto value = T{0};
+        std::memcpy(&value,
+                    reinterpret_cast<const std::uint8_t*>(    // NOLINT
+                        _storage.data())
+                        + byte_offset,
+                    sizeof(T));
+        return value;
+    }
+    template <typename R>
+    typename R::type decode(std::false_type) const noexcept {
+        return load<typename R::type>(register_offset<R>::value);
+    }
+    template <typename R>
+    typename R::type decode(std::true_type) const noexcept {
+        using type = typename R::type;                                // NOLINT
+        using device = typename R::MMIO;                              // NOLINT
+        using word_type = typename TypeTraits<R::bus::size>::type;    // NOLINT
+        using wide_type =                                             // NOLINT
+            typename std::conditional<(sizeof(type) > sizeof(word_type)),
+                                      type,
+                                      word_type>::type;
+        constexpr auto word_bits = TypeTraits<R::bus::size>::bit_size;
+        auto value = type{0};
+        for (std::size_t i = 0; i < device::n_words; ++i) {
+            const auto word = static_cast<wide_type>(load<word_type>(
+                device::first_offset + (i * device::word_bytes)));
+            value = static_cast<type>(
+                value
+                | static_cast<type>(
+                    (i == 0) ? static_cast<wide_type>(word >> device::shift)
+                             : static_cast<wide_type>(
+                                 word << ((i * word_bits) - device::shift))));
+        }
+        return static_cast<type>(
+            value & make_mask<type>(static_cast<FieldWidth>(R::size)));
+    }
+public:
+    PackSnapshot() : _storage{} {};
+    static PackSnapshot capture() noexcept {
+        PackSnapshot snapshot;
+        copy<0, n_accesses>::apply(snapshot._storage);
+        return snapshot;
+    }
+    storage_type& raw() noexcept {
+        return _storage;
+    }
+    const storage_type& raw() const noexcept {
+        return _storage;
+    }
+    template <typename R>
+    typename R::type register_value() const noexcept {
+        return decode<R>(decltype(is_bus_register<R>(nullptr)){});
+    }
+    template <typename R>
+    RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
+    }
+    template <typename F>
+    typename F::value_type read() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::value_type>(
+            static_cast<typename F::type>((value & F::mask) >> F::offset));
+    }
+    template <typename F>
+    bool is_set() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask) == F::mask;
+    }
+    template <typename F>
+    bool is_clear() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask)
+               == typename F::type{0};
+    }
+};
+}    
+#endif    
+
+// PackState.h
+#ifndef CPPREG_PACKSTATE_H
+#define CPPREG_PACKSTATE_H
+namespace cppreg {
+template <typename Register, typename Register::type restore_mask>
+struct MaskedRegister {
+    using reg = Register;    // NOLINT
+    constexpr static auto mask = restore_mask;
+};
+namespace internals {
+template <typename P>
+struct is_restorable_policy    // NOLINT
+    : std::integral_constant<
+          bool,
+          (std::is_base_of<read_write, P>::value
+           || is_atomic_policy<P>::value)
+              && !std::is_base_of<read_to_clear, P>::value
+              && !std::is_base_of<write_only, P>::value
+              && !is_write_1_policy<P>::value> {};
+template <typename T, typename = void>
+struct is_field_type : std::false_type {};    // NOLINT
+template <typename T>
+struct is_field_type<T,
+                     typename std::conditional<
+                         true,
+                         void,
+                         typename T::parent_register>::type>
+    : std::true_type {};
+template <typename Register, typename Register::type mask>
+struct pack_state_entry {    // NOLINT
+    using reg = Register;    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    constexpr static auto combined_mask = mask;
+    type saved_value;
+    pack_state_entry() noexcept : saved_value{Register::reset} {};
+    void save() noexcept {
+        saved_value = Register::ro_mem_device();
+    }
+    bool is_dirty() const noexcept {
+        return static_cast<type>(saved_value & mask)
+               != static_cast<type>(Register::reset & mask);
+    }
+    template <typename T>
+    using if_no_shadow =    // NOLINT
+        typename std::enable_if<!Register::shadow::value, T>::type;
+    template <typename T>
+    using if_shadow =    // NOLINT
+        typename std::enable_if<Register::shadow::value, T>::type;
+    template <typename T = void>
+    void restore(if_no_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::rw_mem_device() = restored_value();
+    }
+    template <typename T = void>
+    void restore(if_shadow<T>* = nullptr) const noexcept {    // NOLINT
+        Register::shadow::shadow_value = restored_value();
+        Register::rw_mem_device() = Register::shadow::shadow_value;
+    }
+    void restore_dirty() const noexcept {
+        if (is_dirty()) {
+            restore();
+        }
+    }
+private:
+    type restored_value() const noexcept {
+        return static_cast<type>(
+            (Register::reset & static_cast<type>(~mask))
+            | (saved_value & mask));
+    }
+};
+template <typename Item, bool is_field = is_field_type<Item>::value>
+struct pack_state_item {    // NOLINT
+    using reg = Item;    // NOLINT
+    constexpr static auto mask = type_mask<typename reg::type>::value;
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+    template <typename E>
+    using merged = entry;    // NOLINT
+    static_assert(is_field,
+                  "PackState:: registers have to be given as fields or as "
+                  "MaskedRegister items");
+};
+template <typename Register, typename Register::type restore_mask>
+struct pack_state_item<MaskedRegister<Register, restore_mask>, false> {
+    using reg = Register;    // NOLINT
+    constexpr static auto mask = restore_mask;
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+    template <typename E>
+    using merged =    // NOLINT
+        pack_state_entry<reg,
+                         static_cast<typename reg::type>(E::combined_mask
+                                                         | mask)>;
+};
+template <typename Item>
+struct pack_state_item<Item, true> {    // NOLINT
+    using reg = typename Item::parent_register;    // NOLINT
+    constexpr static auto mask =
+        is_restorable_policy<typename Item::policy>::value
+            ? Item::mask
+            : typename reg::type{0};
+    using entry = pack_state_entry<reg, mask>;    // NOLINT
+    template <typename E>
+    using merged =    // NOLINT
+        pack_state_entry<reg,
+                         static_cast<typename reg::type>(E::combined_mask
+                                                         | mask)>;
+};
+template <typename List, typename... Items>
+struct pack_state_list {    // NOLINT
+    using type = List;    // NOLINT
+};
+template <typename List, typename Item, typename... Items>
+struct pack_state_list<List, Item, Items...>    // NOLINT
+    : pack_state_list<
+          typename std::conditional<
+              pack_state_item<Item>::mask == 0,
+              List,
+              typename pack_write_insert<List, pack_state_item<Item>>::type>::
+              type,
+          Items...> {};
+template <typename List, typename... Indexed, typename... Items>
+struct pack_state_list<List, PackIndexing<Indexed...>, Items...>    // NOLINT
+    : pack_state_list<List, Indexed..., Items...> {};
+template <typename List>
+class pack_state_storage;    // NOLINT
+template <typename... Entries>
+class pack_state_storage<pack_write_list<Entries...>>    // NOLINT
+    : private Entries... {
+public:
+    constexpr static const std::size_t n_regs = sizeof...(Entries);
+    void save() noexcept {
+        const int expand[] = {0, (static_cast<Entries&>(*this).save(), 0)...};
+        static_cast<void>(expand);
+    }
+    void restore() const noexcept {
+        const int expand[] = {
+            0, (static_cast<const Entries&>(*this).restore(), 0)...};
+        static_cast<void>(expand);
+    }
+    void restore_dirty() const noexcept {
+        const int expand[] = {
+            0, (static_cast<const Entries&>(*this).restore_dirty(), 0)...};
+        static_cast<void>(expand);
+    }
+    template <typename RegisterPack>
+    using is_from_pack =    // NOLINT
+        is_pack_registers<RegisterPack, typename Entries::reg...>;
+};
+}    
+template <typename RegisterPack, typename... Items>
+class PackState {
+private:
+    using storage_type =    // NOLINT
+        internals::pack_state_storage<typename internals::pack_state_list<
+            internals::pack_write_list<>,
+            Items...>::type>;
+    storage_type _storage;    // NOLINT
+public:
+    constexpr static const std::size_t n_regs = storage_type::n_regs;
+    void save() noexcept {
+        _storage.save();
+    }
+    void restore() const noexcept {
+        _storage.restore();
+    }
+    void restore_dirty() const noexcept {
+        _storage.restore_dirty();
+    }
+    static PackState capture() noexcept {
+        PackState state;
+        state.save();
+        return state;
+    }
+    static_assert(storage_type::template is_from_pack<RegisterPack>::value,
+                  "PackState:: register is not from the same pack");
+};
+}    
+#endif    
+
+// PackImage.h
+#ifndef CPPREG_PACKIMAGE_H
+#define CPPREG_PACKIMAGE_H
+namespace cppreg {
+#if __cplusplus >= 201402L
+namespace internals {
+template <typename Device>
+class device_merge_write {    // NOLINT
+private:
+    Device& _device;    // NOLINT
+public:
+    constexpr explicit device_merge_write(Device& device) noexcept
+        : _device{device} {};
+    template <typename F>
+    constexpr device_merge_write with(
+        const typename F::value_type value) const noexcept {
+        _device.template write<F>(value);
+        return *this;
+    }
+    template <typename F, typename F::value_type value>
+    constexpr device_merge_write with() const noexcept {
+        _device.template write<F, value>();
+        return *this;
+    }
+    constexpr void done() const noexcept {}
+};
+}    
+template <typename RegisterPack, RegBitSize max_access_size = RegBitSize::b32>
+class PackImage {
+public:
+    constexpr static const auto access_size =
+        internals::widest_access<RegisterPack::pack_base,
+                                 RegisterPack::size_in_bytes,
+                                 max_access_size>::value;
+    using access_type = typename TypeTraits<access_size>::type;    // NOLINT
+    constexpr static const std::size_t n_accesses =
+        RegisterPack::size_in_bytes / TypeTraits<access_size>::byte_size;
+    using storage_type = access_type[n_accesses];    // NOLINT
+private:
+    using mem_device =    // NOLINT
+        typename RegisterMemoryDevice<RegisterPack>::mem_device;
+    constexpr static const std::size_t word_bytes =
+        TypeTraits<access_size>::byte_size;
+    storage_type _storage;    // NOLINT
+    template <std::size_t index, std::size_t end>
+    struct store_words {    // NOLINT
+        static void apply(const storage_type& storage) noexcept {
+            mem_device::template rw_memory<access_size, index * word_bytes>() =
+                storage[index];
+            store_words<index + 1, end>::apply(storage);
+        }
+    };
+    template <std::size_t end>
+    struct store_words<end, end> {    // NOLINT
+        static void apply(const storage_type&) noexcept {}    // NOLINT
+    };
+    template <typename R>
+    struct register_offset    // NOLINT
+        : std::integral_constant<
+              std::size_t,
+              static_cast<std::size_t>(R::base_address
+                                       - RegisterPack::pack_base)> {
+        static_assert(
+            internals::is_same_pack<typename R::pack, RegisterPack>::value,
+            "PackImage:: register is not from the same pack");
+    };
+    constexpr std::uint8_t get_byte(const std::size_t index) const noexcept {
+        return static_cast<std::uint8_t>(
+            _storage[index / word_bytes]
+            >> (one_byte * (index % word_bytes)));
+    }
+    constexpr void set_byte(const std::size_t index,
+                            const std::uint8_t value) noexcept {
+        const auto shift = one_byte * (index % word_bytes);
+        access_type& word = _storage[index / word_bytes];
+        word = static_cast<access_type>(
+            (word & static_cast<access_type>(~(access_type{0xFF} << shift)))
+            | static_cast<access_type>(access_type{value} << shift));
+    }
+    template <typename F>
+    constexpr void update(const typename F::type value) noexcept {
+        static_assert(!is_write_1_policy<typename F::policy>::value,
+                      "PackImage:: write-1-to-clear/set fields are not "
+                      "supported");
+        static_assert(is_plain_writable_policy<typename F::policy>::value
+                          || is_atomic_policy<typename F::policy>::value,
+                      "PackImage:: field is not writable");
+        using R = typename F::parent_register;
+        const auto current = register_value<R>();
+        write_register<R>(static_cast<typename R::type>(
+            (current & static_cast<typename R::type>(~F::mask))
+            | (static_cast<typename R::type>(value << F::offset) & F::mask)));
+    }
+public:
+    constexpr PackImage() noexcept : _storage{} {};
+    template <typename... Registers>
+    constexpr static PackImage from_reset() noexcept {
+        PackImage image;
+        const int expand[] = {
+            0, (image.template write_register<Registers>(Registers::reset),
+                0)...};
+        static_cast<void>(expand);
+        return image;
+    }
+    constexpr const storage_type& raw() const noexcept {
+        return _storage;
+    }
+    template <typename R>
+    constexpr typename R::type register_value() const noexcept {
+        auto value = typename R::type{0};
+        for (std::size_t i = 0; i < internals::register_byte_size<R>::value;
+             ++i) {
+            value = static_cast<typename R::type>(
+                value
+                | static_cast<typename R::type>(
+                    static_cast<typename R::type>(
+                        get_byte(register_offset<R>::value + i))
+                    << (one_byte * i)));
+        }
+        return value;
+    }
+    template <typename R>
+    constexpr RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
+    }
+    template <typename R>
+    constexpr PackImage& write_register(
+        const typename R::type value) noexcept {
+        for (std::size_t i = 0; i < internals::register_byte_size<R>::value;
+             ++i) {
+            set_byte(register_offset<R>::value + i,
+                     static_cast<std::uint8_t>(value >> (one_byte * i)));
+        }
+        return *this;
+    }
+    template <typename F>
+    constexpr typename F::value_type read() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::value_type>(
+            static_cast<typename F::type>((value & F::mask) >> F::offset));
+    }
+    template <typename F>
+    constexpr bool is_set() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask) == F::mask;
+    }
+    template <typename F>
+    constexpr bool is_clear() const noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        return static_cast<typename F::type>(value & F::mask)
+               == typename F::type{0};
+    }
+    template <typename F>
+    constexpr PackImage& write(const typename F::value_type value) noexcept {
+        update<F>(static_cast<typename F::type>(value));
+        return *this;
+    }
+    template <typename F, typename F::value_type value>
+    constexpr PackImage& write() noexcept {
+        static_assert(
+            internals::check_overflow<typename F::type,
+                                      static_cast<typename F::type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "PackImage::write<value>: value too large for the field");
+        return write<F>(value);
+    }
+    template <typename F>
+    constexpr PackImage& set() noexcept {
+        update<F>(F::mask >> F::offset);
+        return *this;
+    }
+    template <typename F>
+    constexpr PackImage& clear() noexcept {
+        update<F>(typename F::type{0});
+        return *this;
+    }
+    template <typename F>
+    constexpr PackImage& toggle() noexcept {
+        const auto value = register_value<typename F::parent_register>();
+        update<F>(static_cast<typename F::type>(
+            (static_cast<typename F::type>(~value) & F::mask) >> F::offset));
+        return *this;
+    }
+    template <typename F>
+    constexpr internals::device_merge_write<PackImage> merge_write(
+        const typename F::value_type value) noexcept {
+        write<F>(value);
+        return internals::device_merge_write<PackImage>{*this};
+    }
+    template <typename F, typename F::value_type value>
+    constexpr internals::device_merge_write<PackImage> merge_write() noexcept {
+        write<F, value>();
+        return internals::device_merge_write<PackImage>{*this};
+    }
+    void store() const noexcept {
+        store_words<0, n_accesses>::apply(_storage);
+    }
+    template <typename... Registers>
+    void store() const noexcept {
+        const int expand[] = {
+            0, ((Registers::rw_mem_device() = register_value<Registers>()),
+                0)...};
+        static_cast<void>(expand);
+    }
+};
+template <typename RegisterPack>
+struct PackAccess {
+    template <typename R>
+    typename R::type register_value() const noexcept {
+        return R::read_value().raw();
+    }
+    template <typename R>
+    RegisterValue<R> value() const noexcept {
+        return RegisterValue<R>{register_value<R>()};
     }
     template <typename F>
-    static MergeWrite<typename F::parent_register, F::mask> merge_write(
-        const typename F::type value) noexcept {
-        const auto lhs = static_cast<type>(value << F::offset);
-        return MergeWrite<typename F::parent_register, F::mask>::create(
-            static_cast<type>(lhs & F::mask));
+    typename F::value_type read() const noexcept {
+        return F::read();
     }
-    template <typename F,
-              type value,
-              typename T = MergeWrite_tmpl<typename F::parent_register,
-                                           F::mask,
-                                           F::offset,
-                                           value>>
-    static T merge_write() noexcept {
-        static_assert(
-            internals::check_overflow<type, value, (F::mask >> F::offset)>::
-                value,
-            "Register::merge_write<value>:: value too large for the field");
-        return T::create();
+    template <typename F>
+    bool is_set() const noexcept {
+        return F::is_set();
+    }
+    template <typename F>
+    bool is_clear() const noexcept {
+        return F::is_clear();
+    }
+    template <typename F>
+    PackAccess& write(const typename F::value_type value) noexcept {
+        F::write(value);
+        return *this;
+    }
+    template <typename F, typename F::value_type value>
+    PackAccess& write() noexcept {
+        F::template write<value>();
+        return *this;
+    }
+    template <typename F>
+    PackAccess& set() noexcept {
+        F::set();
+        return *this;
+    }
+    template <typename F>
+    PackAccess& clear() noexcept {
+        F::clear();
+        return *this;
+    }
+    template <typename F>
+    PackAccess& toggle() noexcept {
+        F::toggle();
+        return *this;
+    }
+    template <typename F>
+    auto merge_write(const typename F::value_type value) noexcept
+        -> decltype(F::parent_register::template merge_write<F>(value)) {
+        return F::parent_register::template merge_write<F>(value);
+    }
+    template <typename F, typename F::value_type value>
+    auto merge_write() noexcept
+        -> decltype(F::parent_register::template merge_write<F, value>()) {
+        return F::parent_register::template merge_write<F, value>();
     }
-    static_assert(size != 0, "Register:: register definition with zero size");
-    static_assert(internals::is_aligned<reg_address,
-                                        TypeTraits<reg_size>::byte_size>::value,
-                  "Register:: address is mis-aligned for register type");
 };
+#endif    
 }    
 #endif    
 
-// RegisterPack.h
-#ifndef CPPREG_REGISTERPACK_H
-#define CPPREG_REGISTERPACK_H
+// Wait.h
+#ifndef CPPREG_WAIT_H
+#define CPPREG_WAIT_H
 namespace cppreg {
-template <typename RegisterPack,
-          RegBitSize reg_size,
-          std::uint32_t bit_offset,
-          typename TypeTraits<reg_size>::type reset_value = 0x0,
-          bool use_shadow = false>
-struct PackedRegister
-    : Register<RegisterPack::pack_base + (bit_offset / one_byte),
-               reg_size,
-               reset_value,
-               use_shadow> {
-    using pack = RegisterPack;    // NOLINT
-    using base_reg =    // NOLINT
-        Register<RegisterPack::pack_base + (bit_offset / one_byte),
-                 reg_size,
-                 reset_value,
-                 use_shadow>;
-    static typename base_reg::MMIO& rw_mem_device() noexcept {
-        using MemDevice =
-            typename RegisterMemoryDevice<RegisterPack>::mem_device;
-        return MemDevice::template rw_memory<reg_size,
-                                             (bit_offset / one_byte)>();
-    }
-    static const typename base_reg::MMIO& ro_mem_device() noexcept {
-        using MemDevice =
-            typename RegisterMemoryDevice<RegisterPack>::mem_device;
-        return MemDevice::template ro_memory<reg_size,
-                                             (bit_offset / one_byte)>();
-    }
-    static_assert(TypeTraits<reg_size>::byte_size + (bit_offset / one_byte)
-                      <= RegisterPack::size_in_bytes,
-                  "PackRegister:: packed register is overflowing the pack");
-    static_assert(
-        internals::is_aligned<RegisterPack::pack_base,
-                              TypeTraits<reg_size>::byte_size>::value,
-        "PackedRegister:: pack base address is mis-aligned for register type");
-    static_assert(
-        internals::is_aligned<RegisterPack::pack_base + (bit_offset / one_byte),
-                              TypeTraits<reg_size>::byte_size>::value,
-        "PackedRegister:: offset address is mis-aligned for register type");
-};
-template <typename... T>
-struct PackIndexing {
-    using tuple_t = typename std::tuple<T...>;    // NOLINT
-    constexpr static const std::size_t n_elems =
-        std::tuple_size<tuple_t>::value;
-    template <std::size_t n>
-    using elem = typename std::tuple_element<n, tuple_t>::type;    // NOLINT
+struct busy_wait {    // NOLINT
+    static void pause() noexcept {}
 };
-template <std::size_t start, std::size_t end>
-struct for_loop {    // NOLINT
-    template <typename Func>
-    static void apply() noexcept {
-        Func().template operator()<start>();
-        if (start < end) {
-            for_loop<start + 1, end>::template apply<Func>();
-        }
+#if defined(__arm__) || defined(__aarch64__)
+struct wfe_wait {    // NOLINT
+    static void pause() noexcept {
+        __asm__ volatile("wfe");
     }
-#if __cplusplus >= 201402L
-    template <typename Op>
-    static void apply(Op&& f) noexcept {
-        if (start < end) {
-            f(std::integral_constant<std::size_t, start>{});
-            for_loop<start + 1, end>::apply(std::forward<Op>(f));
-        };
+};
+struct yield_wait {    // NOLINT
+    static void pause() noexcept {
+        __asm__ volatile("yield");
     }
-#endif    
 };
-template <std::size_t end>
-struct for_loop<end, end> {
-    template <typename Func>
-    static void apply() noexcept {}
-#if __cplusplus >= 201402L
-    template <typename Op>
-    static void apply(Op&&) noexcept {}    // NOLINT
-#endif
+#endif    
+struct dwt_cycle_counter {    // NOLINT
+    using tick_type = std::uint32_t;    // NOLINT
+    constexpr static const Address cyccnt_address = 0xE0001004;
+    static tick_type now() noexcept {
+        return *(reinterpret_cast<const volatile tick_type*>(    // NOLINT
+            cyccnt_address));
+    }
 };
-template <typename IndexedPack>
-struct pack_loop : for_loop<0, IndexedPack::n_elems> {};    // NOLINT
 }    
 #endif    
 
@@ -531,38 +3386,67 @@ template <typename BaseRegister,
 struct Field {
     using parent_register = BaseRegister;    // NOLINT
     using type = typename parent_register::type;    // NOLINT
+    using value_type = type;    // NOLINT
     using MMIO = typename parent_register::MMIO;    // NOLINT
     using policy = AccessPolicy;    // NOLINT
+    using mem_policy =    // NOLINT
+        typename internals::register_policy<AccessPolicy,
+                                            parent_register>::type;
     constexpr static auto width = field_width;
     constexpr static auto offset = field_offset;
     constexpr static auto mask = make_shifted_mask<type>(width, offset);
+    template <type value>
+    using eq = internals::field_match<Field, value>;    // NOLINT
+    using all_set = eq<(mask >> offset)>;               // NOLINT
+    using all_clear = eq<0>;                            // NOLINT
     template <type value, typename T>
     using if_no_shadow =    // NOLINT
         typename std::enable_if<!parent_register::shadow::value, T>::type;
     template <type value, typename T>
     using if_shadow =    // NOLINT
         typename std::enable_if<parent_register::shadow::value, T>::type;
-    static type read() noexcept {
-        return policy::template read<MMIO, type, mask, offset>(
+    template <typename T>
+    using if_no_shadow_read =    // NOLINT
+        typename std::enable_if<!parent_register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_shadow_read =    // NOLINT
+        typename std::enable_if<parent_register::shadow_read::value, T>::type;
+    template <typename T>
+    using if_memory_read =    // NOLINT
+        typename std::enable_if<
+            !parent_register::shadow_read::value
+                || !std::is_base_of<read_write, AccessPolicy>::value,
+            T>::type;
+    template <typename T>
+    using if_shadow_value_read =    // NOLINT
+        typename std::enable_if<
+            parent_register::shadow_read::value
+                && std::is_base_of<read_write, AccessPolicy>::value,
+            T>::type;
+    template <typename T = type>
+    static T read(if_memory_read<T>* = nullptr) noexcept {    // NOLINT
+        return mem_policy::template read<MMIO, type, mask, offset>(
             parent_register::ro_mem_device());
     }
     template <typename T = type>
+    static T read(if_shadow_value_read<T>* = nullptr) noexcept {    // NOLINT
+        return policy::template read<type, type, mask, offset>(
+            parent_register::shadow::shadow_value);
+    }
+    template <typename T = type>
     static void write(const if_no_shadow<type{0}, T> value) noexcept {
-        policy::template write<MMIO, type, mask, offset>(
+        mem_policy::template write<MMIO, type, mask, offset>(
             parent_register::rw_mem_device(), value);
     }
     template <typename T = type>
     static void write(const if_shadow<type{0}, T> value) noexcept {
         RegisterWrite<type, type, mask, offset>::write(
             parent_register::shadow::shadow_value, value);
-        policy::
-            template write<MMIO, type, type_mask<type>::value, FieldOffset{0}>(
-                parent_register::rw_mem_device(),
-                parent_register::shadow::shadow_value);
+        write_shadow_value();
     }
     template <type value, typename T = void>
     static void write(if_no_shadow<value, T>* = nullptr) noexcept {    // NOLINT
-        policy::template write<MMIO, type, mask, offset, value>(
+        mem_policy::template write<MMIO, type, mask, offset, value>(
             parent_register::rw_mem_device());
         static_assert(
             internals::check_overflow<type, value, (mask >> offset)>::value,
@@ -575,32 +3459,606 @@ struct Field {
             internals::check_overflow<type, value, (mask >> offset)>::value,
             "Field::write<value>: value too large for the field");
     }
-    static void set() noexcept {
-        policy::template set<MMIO, type, mask>(
+    template <typename T = void>
+    static void set(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template set<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
-    static void clear() noexcept {
-        policy::template clear<MMIO, type, mask>(
+    template <typename T = void>
+    static void set(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template set<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
+    template <typename T = void>
+    static void clear(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template clear<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
-    static void toggle() noexcept {
-        policy::template toggle<MMIO, type, mask>(
+    template <typename T = void>
+    static void clear(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template clear<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
+    template <typename T = void>
+    static void toggle(if_no_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        mem_policy::template toggle<MMIO, type, mask>(
             parent_register::rw_mem_device());
     }
+    template <typename T = void>
+    static void toggle(if_shadow_read<T>* = nullptr) noexcept {    // NOLINT
+        policy::template toggle<type, type, mask>(
+            parent_register::shadow::shadow_value);
+        write_shadow_value();
+    }
     static bool is_set() noexcept {
         return (Field::read() == (mask >> offset));
     }
     static bool is_clear() noexcept {
         return (Field::read() == type{0});
     }
+    template <type value, typename Wait = busy_wait>
+    static void wait_until_equal() noexcept {
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "Field::wait_until_equal<value>: value too large for the field");
+        while (!is_equal_raw<value>()) {
+            Wait::pause();
+        }
+    }
+    template <type value, typename Clock, typename Wait = busy_wait>
+    static bool wait_until_equal(
+        const typename Clock::tick_type timeout) noexcept {
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "Field::wait_until_equal<value>: value too large for the field");
+        const auto start = Clock::now();
+        while (!is_equal_raw<value>()) {
+            if (static_cast<typename Clock::tick_type>(Clock::now() - start)
+                >= timeout) {
+                return is_equal_raw<value>();
+            }
+            Wait::pause();
+        }
+        return true;
+    }
+    template <typename Wait = busy_wait>
+    static void wait_until_set() noexcept {
+        wait_until_equal<(mask >> offset), Wait>();
+    }
+    template <typename Clock, typename Wait = busy_wait>
+    static bool wait_until_set(
+        const typename Clock::tick_type timeout) noexcept {
+        return wait_until_equal<(mask >> offset), Clock, Wait>(timeout);
+    }
+    template <typename Wait = busy_wait>
+    static void wait_until_clear() noexcept {
+        wait_until_equal<type{0}, Wait>();
+    }
+    template <typename Clock, typename Wait = busy_wait>
+    static bool wait_until_clear(
+        const typename Clock::tick_type timeout) noexcept {
+        return wait_until_equal<type{0}, Clock, Wait>(timeout);
+    }
     static_assert(parent_register::size >= width,
                   "Field:: field width is larger than parent register size");
     static_assert(parent_register::size >= width + offset,
                   "Field:: offset + width is larger than parent register size");
     static_assert(width != FieldWidth{0},
                   "Field:: defining a Field type of zero width is not allowed");
+    static_assert(!parent_register::shadow::value
+                      || is_shadow_compatible_policy<AccessPolicy>::value,
+                  "Field:: access policy is not supported with shadow value");
+    static_assert(!std::is_base_of<bit_band_read_write, AccessPolicy>::value
+                      || ((mask != type{0})
+                          && ((mask & (mask - 1U)) == type{0})),
+                  "Field:: bit-band requires a single bit field");
+    static_assert(internals::is_policy_alias_in_memory<parent_register>(
+                      static_cast<const AccessPolicy*>(nullptr)),
+                  "Field:: alias register is outside of the pack memory");
+private:
+    template <type value>
+    static bool is_equal_raw() noexcept {
+        static_assert(
+            std::is_same<decltype(policy::template read<MMIO,
+                                                        type,
+                                                        mask,
+                                                        offset>(
+                             parent_register::ro_mem_device())),
+                         type>::value,
+            "Field::wait_until:: field is not readable");
+        return RegisterRead<MMIO, type, mask, FieldOffset{0}>::read(
+                   parent_register::ro_mem_device())
+               == static_cast<type>(value << offset);
+    }
+    static void write_shadow_value() noexcept {
+        policy::
+            template write<MMIO, type, type_mask<type>::value, FieldOffset{0}>(
+                parent_register::rw_mem_device(),
+                parent_register::shadow::shadow_value);
+    }
+};
+template <typename BaseRegister,
+          FieldWidth field_width,
+          FieldOffset field_offset,
+          typename AccessPolicy,
+          typename Enum>
+struct EnumField
+    : Field<BaseRegister, field_width, field_offset, AccessPolicy> {
+    using base_field =    // NOLINT
+        Field<BaseRegister, field_width, field_offset, AccessPolicy>;
+    using type = typename base_field::type;    // NOLINT
+    using value_type = Enum;    // NOLINT
+    template <Enum value>
+    using eq =    // NOLINT
+        internals::field_match<EnumField, static_cast<type>(value)>;
+    static Enum read() noexcept {
+        return static_cast<Enum>(base_field::read());
+    }
+    static void write(const Enum value) noexcept {
+        base_field::write(static_cast<type>(value));
+    }
+    template <Enum value>
+    static void write() noexcept {
+        base_field::template write<static_cast<type>(value)>();
+    }
+    template <Enum value, typename Wait = busy_wait>
+    static void wait_until_equal() noexcept {
+        base_field::template wait_until_equal<static_cast<type>(value),
+                                              Wait>();
+    }
+    template <Enum value, typename Clock, typename Wait = busy_wait>
+    static bool wait_until_equal(
+        const typename Clock::tick_type timeout) noexcept {
+        return base_field::template wait_until_equal<static_cast<type>(value),
+                                                     Clock,
+                                                     Wait>(timeout);
+    }
+    static_assert(std::is_enum<Enum>::value,
+                  "EnumField:: value type is not an enumeration");
 };
 }    
-#endif
+#endif    
+
+// FifoRegister.h
+#ifndef CPPREG_FIFOREGISTER_H
+#define CPPREG_FIFOREGISTER_H
+namespace cppreg {
+template <typename Register, typename T = typename Register::type>
+struct FifoRegister {
+    using reg = Register;    // NOLINT
+    using type = typename Register::type;    // NOLINT
+    using value_type = T;    // NOLINT
+    using MMIO = typename Register::MMIO;    // NOLINT
+    constexpr static const Address address = Register::base_address;
+    constexpr static const std::size_t unroll = 4U;
+    static void write_burst(const T* data, std::size_t n) noexcept {
+        MMIO& mmio_device = Register::rw_mem_device();
+        for (; n >= unroll; n -= unroll, data += unroll) {
+            mmio_device = static_cast<type>(data[0]);
+            mmio_device = static_cast<type>(data[1]);
+            mmio_device = static_cast<type>(data[2]);
+            mmio_device = static_cast<type>(data[3]);
+        }
+        for (; n != 0U; --n, ++data) {
+            mmio_device = static_cast<type>(*data);
+        }
+    }
+    static void read_burst(T* out, std::size_t n) noexcept {
+        const MMIO& mmio_device = Register::ro_mem_device();
+        for (; n >= unroll; n -= unroll, out += unroll) {
+            out[0] = static_cast<T>(static_cast<type>(mmio_device));
+            out[1] = static_cast<T>(static_cast<type>(mmio_device));
+            out[2] = static_cast<T>(static_cast<type>(mmio_device));
+            out[3] = static_cast<T>(static_cast<type>(mmio_device));
+        }
+        for (; n != 0U; --n, ++out) {
+            *out = static_cast<T>(static_cast<type>(mmio_device));
+        }
+    }
+    template <typename Level, std::size_t depth, typename Wait = busy_wait>
+    static void write_burst(const T* data, std::size_t n) noexcept {
+        while (n != 0U) {
+            std::size_t level = Level::read();
+            while (level >= depth) {
+                Wait::pause();
+                level = Level::read();
+            }
+            const std::size_t count = (depth - level < n) ? depth - level : n;
+            write_burst(data, count);
+            data += count;
+            n -= count;
+        }
+    }
+    template <typename Level, typename Wait = busy_wait>
+    static void read_burst(T* out, std::size_t n) noexcept {
+        while (n != 0U) {
+            std::size_t level = Level::read();
+            while (level == 0U) {
+                Wait::pause();
+                level = Level::read();
+            }
+            const std::size_t count = (level < n) ? level : n;
+            read_burst(out, count);
+            out += count;
+            n -= count;
+        }
+    }
+    template <typename Transfer>
+    static void transfer_write(const T* data, const std::size_t n) noexcept {
+        Transfer::write(address, data, n);
+    }
+    template <typename Transfer>
+    static void transfer_read(T* out, const std::size_t n) noexcept {
+        Transfer::read(address, out, n);
+    }
+    static_assert(!Register::shadow::value,
+                  "FifoRegister:: shadow value registers are not supported");
+};
+}    
+#endif    
+
+// SharedShadow.h
+#ifndef CPPREG_SHAREDSHADOW_H
+#define CPPREG_SHAREDSHADOW_H
+namespace cppreg {
+struct no_lock {    // NOLINT
+    static void lock() noexcept {}
+    static void unlock() noexcept {}
+};
+struct locked_store {    // NOLINT
+    constexpr static const bool lock_free = false;
+    template <typename MMIO, typename T>
+    static void store(MMIO& mmio_device,
+                      const T,
+                      const T,
+                      T (*const combined)()) noexcept {
+        RegisterWrite<MMIO, T, type_mask<T>::value, FieldOffset{0}>::write(
+            mmio_device, combined());
+    }
+};
+template <std::ptrdiff_t toggle_offset>
+struct toggle_alias_store {    // NOLINT
+    constexpr static const bool lock_free = true;
+    template <typename MMIO, typename T>
+    static void store(MMIO& mmio_device,
+                      const T previous,
+                      const T value,
+                      T (*const)()) noexcept {
+        using alias = RegisterAlias<MMIO, toggle_offset>;
+        RegisterWrite<typename alias::alias_type,
+                      T,
+                      type_mask<T>::value,
+                      FieldOffset{0}>::write(alias::get(mmio_device),
+                                             static_cast<T>(previous ^ value));
+    }
+};
+namespace internals {
+template <typename Register, std::ptrdiff_t toggle_offset>
+constexpr bool is_policy_alias_in_memory(
+    const toggle_alias_store<toggle_offset>*) noexcept {
+    return is_alias_in_memory<Register, toggle_offset>::value;
+}
+template <typename T, typename... Fields>
+struct combined_field_mask : std::integral_constant<T, 0> {};    // NOLINT
+template <typename T, typename F, typename... Fields>
+struct combined_field_mask<T, F, Fields...>    // NOLINT
+    : std::integral_constant<
+          T,
+          static_cast<T>(F::mask
+                         | combined_field_mask<T, Fields...>::value)> {};
+template <typename T, T seen, T shared, typename... Partitions>
+struct shadow_partitions_overlap    // NOLINT
+    : std::integral_constant<T, shared> {};
+template <typename T, T seen, T shared, typename P, typename... Partitions>
+struct shadow_partitions_overlap<T, seen, shared, P, Partitions...>    // NOLINT
+    : shadow_partitions_overlap<
+          T,
+          static_cast<T>(seen | P::template mask<T>::value),
+          static_cast<T>(shared | (seen & P::template mask<T>::value)),
+          Partitions...> {};
+template <typename T, typename... Partitions>
+struct shadow_partitions_mask : std::integral_constant<T, 0> {};    // NOLINT
+template <typename T, typename P, typename... Partitions>
+struct shadow_partitions_mask<T, P, Partitions...>    // NOLINT
+    : std::integral_constant<
+          T,
+          static_cast<T>(P::template mask<T>::value
+                         | shadow_partitions_mask<T, Partitions...>::value)> {
+};
+template <typename Owner, typename... Partitions>
+struct owner_partition {    // NOLINT
+    using type = void;      // NOLINT
+};
+template <typename Owner, typename P, typename... Partitions>
+struct owner_partition<Owner, P, Partitions...> {    // NOLINT
+    using type = typename std::conditional<    // NOLINT
+        std::is_same<typename P::owner, Owner>::value,
+        P,
+        typename owner_partition<Owner, Partitions...>::type>::type;
+};
+template <typename... Partitions>
+struct shadow_unique_owners : std::true_type {};    // NOLINT
+template <typename P, typename... Partitions>
+struct shadow_unique_owners<P, Partitions...>    // NOLINT
+    : std::integral_constant<
+          bool,
+          std::is_void<typename owner_partition<typename P::owner,
+                                                Partitions...>::type>::value
+              && shadow_unique_owners<Partitions...>::value> {};
+template <typename Register, typename Owner, typename Register::type mask>
+struct shadow_partition {    // NOLINT
+    static typename Register::type value;
+};
+template <typename Register, typename Owner, typename Register::type mask>
+typename Register::type shadow_partition<Register, Owner, mask>::value =
+    static_cast<typename Register::type>(Register::reset & mask);
+template <typename Lock, bool enabled>
+struct shadow_lock_guard {    // NOLINT
+    shadow_lock_guard() noexcept {
+        Lock::lock();
+    }
+    ~shadow_lock_guard() noexcept {
+        Lock::unlock();
+    }
+    shadow_lock_guard(const shadow_lock_guard&) = delete;
+    shadow_lock_guard& operator=(const shadow_lock_guard&) = delete;
+};
+template <typename Lock>
+struct shadow_lock_guard<Lock, false> {};    // NOLINT
+}    
+template <typename Owner, typename... Fields>
+struct ShadowPartition {
+    using owner = Owner;    // NOLINT
+    template <typename T>
+    using mask = internals::combined_field_mask<T, Fields...>;    // NOLINT
+};
+template <typename Register,
+          typename Lock,
+          typename Store,
+          typename... Partitions>
+class SharedShadow {
+public:
+    using type = typename Register::type;    // NOLINT
+    constexpr static const type owned_mask =
+        internals::shadow_partitions_mask<type, Partitions...>::value;
+    constexpr static const type shared_mask =
+        internals::shadow_partitions_overlap<type,
+                                             type{0},
+                                             type{0},
+                                             Partitions...>::value;
+private:
+    template <typename Owner>
+    using exclusive_mask =    // NOLINT
+        std::integral_constant<
+            type,
+            static_cast<type>(
+                internals::owner_partition<Owner, Partitions...>::type::
+                    template mask<type>::value
+                & static_cast<type>(~shared_mask))>;
+    template <typename Owner>
+    using exclusive_partition =    // NOLINT
+        internals::shadow_partition<Register,
+                                    Owner,
+                                    exclusive_mask<Owner>::value>;
+    using shared_partition =    // NOLINT
+        internals::shadow_partition<Register, void, shared_mask>;
+    template <typename Owner, typename F>
+    static void update(const type mask, const type shifted_value) noexcept {
+        using partition =
+            typename internals::owner_partition<Owner, Partitions...>::type;
+        static_assert(!std::is_void<partition>::value,
+                      "SharedShadow:: owner has no partition");
+        static_assert(
+            std::is_same<typename F::parent_register, Register>::value,
+            "SharedShadow:: field is not from the same register");
+        constexpr auto owned = partition::template mask<type>::value;
+        static_assert((F::mask & static_cast<type>(~owned)) == type{0},
+                      "SharedShadow:: field is not owned by the owner");
+        constexpr auto is_shared = (F::mask & shared_mask) != type{0};
+        static_assert(!is_shared || ((F::mask & shared_mask) == F::mask),
+                      "SharedShadow:: field is partially shared");
+        using storage =
+            typename std::conditional<is_shared,
+                                      shared_partition,
+                                      exclusive_partition<Owner>>::type;
+        internals::shadow_lock_guard<
+            Lock,
+            is_shared || (!Store::lock_free && (sizeof...(Partitions) > 1))>
+            guard;
+        static_cast<void>(guard);
+        const type previous = storage::value;
+        storage::value = static_cast<type>(
+            (previous & static_cast<type>(~mask)) | (shifted_value & mask));
+        Store::store(Register::rw_mem_device(),
+                     previous,
+                     storage::value,
+                     &combined);
+    }
+    static type combined() noexcept {
+        type result = static_cast<type>(Register::reset
+                                        & static_cast<type>(~owned_mask));
+        const int expand[] = {
+            0,
+            (result = static_cast<type>(
+                 result
+                 | exclusive_partition<typename Partitions::owner>::value),
+             0)...};
+        static_cast<void>(expand);
+        return static_cast<type>(result | shared_partition::value);
+    }
+public:
+    static type shadow_value() noexcept {
+        return combined();
+    }
+    template <typename F>
+    static typename F::value_type read() noexcept {
+        return static_cast<typename F::value_type>(
+            static_cast<type>((combined() & F::mask) >> F::offset));
+    }
+    template <typename Owner, typename F>
+    static void write(const typename F::value_type value) noexcept {
+        update<Owner, F>(
+            F::mask,
+            static_cast<type>(static_cast<type>(value) << F::offset));
+    }
+    template <typename Owner, typename F, typename F::value_type value>
+    static void write() noexcept {
+        static_assert(
+            internals::check_overflow<type,
+                                      static_cast<type>(value),
+                                      (F::mask >> F::offset)>::value,
+            "SharedShadow::write<value>: value too large for the field");
+        write<Owner, F>(value);
+    }
+    template <typename Owner, typename F>
+    static void set() noexcept {
+        update<Owner, F>(F::mask, F::mask);
+    }
+    template <typename Owner, typename F>
+    static void clear() noexcept {
+        update<Owner, F>(F::mask, type{0});
+    }
+    static void store() noexcept {
+        internals::shadow_lock_guard<Lock, true> guard;
+        static_cast<void>(guard);
+        RegisterWrite<typename Register::MMIO,
+                      type,
+                      type_mask<type>::value,
+                      FieldOffset{0}>::write(Register::rw_mem_device(),
+                                             combined());
+    }
+    static_assert(internals::shadow_unique_owners<Partitions...>::value,
+                  "SharedShadow:: owner has several partitions");
+    static_assert(!Register::shadow::value,
+                  "SharedShadow:: register shadow value has to be disabled");
+    static_assert(
+        internals::is_policy_alias_in_memory<Register>(
+            static_cast<const Store*>(nullptr)),
+        "SharedShadow:: alias register is outside of the pack memory");
+};
+}    
+#endif    
+
+// RegisterArray.h
+#ifndef CPPREG_REGISTERARRAY_H
+#define CPPREG_REGISTERARRAY_H
+namespace cppreg {
+template <typename RegisterPack,
+          RegBitSize reg_size,
+          std::uint32_t first_bit_offset,
+          std::uint32_t bit_stride,
+          std::size_t count,
+          typename TypeTraits<reg_size>::type reset_value = 0x0>
+struct RegisterArray {
+    using pack = RegisterPack;    // NOLINT
+    using type = typename TypeTraits<reg_size>::type;    // NOLINT
+    constexpr static auto size = TypeTraits<reg_size>::bit_size;
+    constexpr static const std::size_t n_elems = count;
+    constexpr static const std::size_t stride_in_bytes = bit_stride / one_byte;
+    template <std::size_t n>
+    using elem =    // NOLINT
+        PackedRegister<RegisterPack,
+                       reg_size,
+                       first_bit_offset + (n * bit_stride),
+                       reset_value>;
+    using MMIO = typename elem<0>::MMIO;    // NOLINT
+    static MMIO& rw_mem_device(const std::size_t index) noexcept {
+        static_assert(std::is_same<MMIO, volatile type>::value,
+                      "RegisterArray:: runtime indexing requires a memory "
+                      "device with plain memory");
+        return *(reinterpret_cast<MMIO*>(    // NOLINT
+            reinterpret_cast<std::uintptr_t>(&elem<0>::rw_mem_device())
+            + (index * stride_in_bytes)));
+    }
+    static const MMIO& ro_mem_device(const std::size_t index) noexcept {
+        return rw_mem_device(index);
+    }
+    static_assert(count != 0U, "RegisterArray:: array has no element");
+    static_assert(bit_stride >= TypeTraits<reg_size>::bit_size,
+                  "RegisterArray:: stride is smaller than register size");
+    static_assert(
+        (bit_stride % TypeTraits<reg_size>::bit_size) == 0U,
+        "RegisterArray:: stride is not a multiple of the register size");
+    static_assert(TypeTraits<reg_size>::byte_size
+                          + ((first_bit_offset
+                              + ((count - 1U) * bit_stride))
+                             / one_byte)
+                      <= RegisterPack::size_in_bytes,
+                  "RegisterArray:: register array is overflowing the pack");
+};
+template <typename BaseArray,
+          FieldWidth field_width,
+          FieldOffset field_offset,
+          typename AccessPolicy>
+struct ArrayField {
+    using parent_array = BaseArray;    // NOLINT
+    using type = typename parent_array::type;    // NOLINT
+    using MMIO = typename parent_array::MMIO;    // NOLINT
+    using policy = AccessPolicy;    // NOLINT
+    constexpr static auto width = field_width;
+    constexpr static auto offset = field_offset;
+    constexpr static auto mask = make_shifted_mask<type>(width, offset);
+    template <std::size_t n>
+    using at =    // NOLINT
+        Field<typename parent_array::template elem<n>, width, offset, policy>;
+    static type read(const std::size_t index) noexcept {
+        return policy::template read<MMIO, type, mask, offset>(
+            parent_array::ro_mem_device(index));
+    }
+    static void write(const std::size_t index, const type value) noexcept {
+        policy::template write<MMIO, type, mask, offset>(
+            parent_array::rw_mem_device(index), value);
+    }
+    template <type value>
+    static void write(const std::size_t index) noexcept {
+        policy::template write<MMIO, type, mask, offset, value>(
+            parent_array::rw_mem_device(index));
+        static_assert(
+            internals::check_overflow<type, value, (mask >> offset)>::value,
+            "ArrayField::write<value>: value too large for the field");
+    }
+    static void set(const std::size_t index) noexcept {
+        policy::template set<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+    static void clear(const std::size_t index) noexcept {
+        policy::template clear<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+    static void toggle(const std::size_t index) noexcept {
+        policy::template toggle<MMIO, type, mask>(
+            parent_array::rw_mem_device(index));
+    }
+    static bool is_set(const std::size_t index) noexcept {
+        return (read(index) == (mask >> offset));
+    }
+    static bool is_clear(const std::size_t index) noexcept {
+        return (read(index) == type{0});
+    }
+    static_assert(parent_array::size >= width,
+                  "ArrayField:: field width is larger than register size");
+    static_assert(parent_array::size >= width + offset,
+                  "ArrayField:: offset + width is larger than register size");
+    static_assert(
+        width != FieldWidth{0},
+        "ArrayField:: defining a Field type of zero width is not allowed");
+    static_assert(!std::is_base_of<bit_band_read_write, AccessPolicy>::value
+                      || ((mask != type{0})
+                          && ((mask & (mask - 1U)) == type{0})),
+                  "ArrayField:: bit-band requires a single bit field");
+    static_assert(
+        internals::is_policy_alias_in_memory<
+            typename parent_array::template elem<0>>(
+            static_cast<const AccessPolicy*>(nullptr))
+            && internals::is_policy_alias_in_memory<
+                typename parent_array::template elem<parent_array::n_elems
+                                                     - 1>>(
+                static_cast<const AccessPolicy*>(nullptr)),
+        "ArrayField:: alias register is outside of the pack memory");
+};
+}    
+#endif    
 
 /* clang-format on */
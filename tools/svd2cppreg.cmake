@@ -0,0 +1,55 @@
+# -------------------------------------------------------------------------- #
+# cppreg SVD generator CMake script
+#
+# Nicolas Clauvelin (nclauvelin@sendyne.com)
+# Sendyne Corp., 2022
+#
+# cppreg_generate_svd(<target> SVD <file> [OUTPUT <header>]
+#                     [NAMESPACE <name>])
+#
+# This defines an interface library <target> (linked to cppreg) providing the
+# register definitions generated from the SVD file by svd2cppreg.py. The
+# header is regenerated when the SVD file or the generator are modified; by
+# default the header is <target>.h in the current binary directory.
+#
+# This requires CMake 3.19 (dependencies of interface libraries).
+# -------------------------------------------------------------------------- #
+
+
+set(cppreg_svd_generator "${CMAKE_CURRENT_LIST_DIR}/svd2cppreg.py"
+    CACHE INTERNAL "cppreg SVD generator script")
+
+function(cppreg_generate_svd target)
+    if(CMAKE_VERSION VERSION_LESS 3.19)
+        message(FATAL_ERROR "cppreg_generate_svd: CMake 3.19 is required")
+    endif()
+    cmake_parse_arguments(svd "" "SVD;OUTPUT;NAMESPACE" "" ${ARGN})
+    if(NOT svd_SVD)
+        message(FATAL_ERROR "cppreg_generate_svd: missing SVD file")
+    endif()
+    if(NOT svd_OUTPUT)
+        set(svd_OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/${target}.h")
+    endif()
+    get_filename_component(svd_file "${svd_SVD}" ABSOLUTE)
+    get_filename_component(svd_dir "${svd_OUTPUT}" DIRECTORY)
+    set(svd_args "")
+    if(svd_NAMESPACE)
+        set(svd_args --namespace ${svd_NAMESPACE})
+    endif()
+
+    find_package(Python3 REQUIRED COMPONENTS Interpreter)
+    add_custom_command(
+        OUTPUT "${svd_OUTPUT}"
+        COMMAND "${CMAKE_COMMAND}" -E make_directory "${svd_dir}"
+        COMMAND Python3::Interpreter "${cppreg_svd_generator}"
+                "${svd_file}" "${svd_OUTPUT}" ${svd_args}
+        DEPENDS "${svd_file}" "${cppreg_svd_generator}"
+        COMMENT "Generating cppreg definitions from ${svd_SVD}"
+        VERBATIM)
+    add_custom_target(${target}_generate DEPENDS "${svd_OUTPUT}")
+
+    add_library(${target} INTERFACE)
+    add_dependencies(${target} ${target}_generate)
+    target_include_directories(${target} INTERFACE "${svd_dir}")
+    target_link_libraries(${target} INTERFACE cppreg)
+endfunction()
@@ -0,0 +1,456 @@
+#!/usr/bin/env python3
+# -------------------------------------------------------------------------- #
+# cppreg SVD generator
+#
+# Nicolas Clauvelin (nclauvelin@sendyne.com)
+# Sendyne Corp., 2022
+#
+# This script generates cppreg register definitions from a CMSIS-SVD file:
+# - each peripheral is a struct with a Pack type and its registers,
+# - registers are PackedRegister types (with the SVD reset values) and fields
+#   are Field types with the access policy derived from the SVD access
+#   properties (modifiedWriteValues and readAction included); fields using
+#   dim are expanded into one Field per element,
+# - registers using dim (or contained in a cluster using dim) are
+#   RegisterArray types with ArrayField fields, and a PackIndexing table is
+#   defined for each field of the array,
+# - peripherals with the same layout share a single definition (a template
+#   over the base address), such that the register definitions are only
+#   instantiated when used.
+#
+# Usage: svd2cppreg.py <file.svd> <output.h> [--namespace name]
+# -------------------------------------------------------------------------- #
+
+
+import argparse
+import re
+import sys
+import textwrap
+import xml.etree.ElementTree as ET
+
+
+# Register sizes supported by cppreg.
+REG_SIZES = {8: "b8", 16: "b16", 32: "b32", 64: "b64"}
+
+# Names which cannot be used for generated members or types.
+RESERVED = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
+    "bool", "break", "case", "catch", "char", "class", "compl", "const",
+    "constexpr", "const_cast", "continue", "decltype", "default", "delete",
+    "do", "double", "dynamic_cast", "else", "enum", "explicit", "export",
+    "extern", "false", "float", "for", "friend", "goto", "if", "inline",
+    "int", "long", "mutable", "namespace", "new", "noexcept", "not",
+    "not_eq", "nullptr", "operator", "or", "or_eq", "private", "protected",
+    "public", "register", "reinterpret_cast", "return", "short", "signed",
+    "sizeof", "static", "static_assert", "static_cast", "struct", "switch",
+    "template", "this", "thread_local", "throw", "true", "try", "typedef",
+    "typeid", "typename", "union", "unsigned", "using", "virtual", "void",
+    "volatile", "wchar_t", "while", "xor", "xor_eq",
+    # Members of the cppreg types.
+    "Pack", "MMIO", "base_address", "elem", "mask", "n_elems", "pack",
+    "policy", "reset", "shadow", "shadow_read", "size", "type",
+}
+
+
+class GeneratorError(Exception):
+    """Error raised for unsupported or invalid SVD content."""
+
+
+def parse_int(text):
+    """Parse a SVD scaled non-negative integer."""
+    text = text.strip().lower()
+    if text.startswith("#"):
+        return int(text[1:].replace("x", "0"), 2)
+    if text.startswith("0b"):
+        return int(text[2:].replace("x", "0"), 2)
+    return int(text, 0)
+
+
+def child_text(node, tag, default=None):
+    """Text of a child element (or default if missing)."""
+    child = node.find(tag)
+    if child is None or child.text is None:
+        return default
+    return child.text.strip()
+
+
+def identifier(name, context=()):
+    """C++ identifier for a SVD name."""
+    name = re.sub(r"\[%s\]|%s", "", name)
+    name = re.sub(r"[^A-Za-z0-9_]+", "_", name)
+    name = re.sub(r"_+", "_", name).lstrip("_")
+    if not name or name[0].isdigit():
+        name = "N" + name
+    candidate = name
+    if candidate in RESERVED or candidate in context:
+        candidate = name + "_"
+    index = 1
+    while candidate in RESERVED or candidate in context:
+        candidate = "{}_{}".format(name.rstrip("_"), index)
+        index += 1
+    return candidate
+
+
+def description(node):
+    """Normalized description of an element."""
+    text = child_text(node, "description", "")
+    return " ".join(text.split())
+
+
+def comment(text, indent):
+    """Doc comment lines for a description."""
+    if not text:
+        return []
+    return textwrap.wrap(text,
+                         width=80,
+                         initial_indent=indent + "//! ",
+                         subsequent_indent=indent + "//! ")
+
+
+class Properties:
+    """Register properties inherited from the parent elements."""
+
+    def __init__(self, size=32, access="read-write", reset=0,
+                 reset_mask=None, modified=None, read_action=None):
+        self.size = size
+        self.access = access
+        self.reset = reset
+        self.reset_mask = reset_mask
+        self.modified = modified
+        self.read_action = read_action
+
+    def derive(self, node):
+        """Properties overridden by an element."""
+        props = Properties(self.size, self.access, self.reset,
+                           self.reset_mask, self.modified, self.read_action)
+        if child_text(node, "size") is not None:
+            props.size = parse_int(child_text(node, "size"))
+        props.access = child_text(node, "access", props.access)
+        if child_text(node, "resetValue") is not None:
+            props.reset = parse_int(child_text(node, "resetValue"))
+        if child_text(node, "resetMask") is not None:
+            props.reset_mask = parse_int(child_text(node, "resetMask"))
+        props.modified = child_text(node, "modifiedWriteValues",
+                                    props.modified)
+        props.read_action = child_text(node, "readAction",
+                                       props.read_action)
+        return props
+
+
+def access_policy(access, modified, read_action, name):
+    """cppreg access policy for SVD access properties."""
+    if access == "read-only":
+        return "read_to_clear" if read_action == "clear" else "read_only"
+    if access in ("write-only", "writeOnce"):
+        return "write_only"
+    if modified == "oneToClear":
+        return "write_1_to_clear"
+    if modified == "oneToSet":
+        return "write_1_to_set"
+    if modified not in (None, "modify"):
+        # No cppreg policy models the other write side effects (e.g.,
+        # oneToToggle, zeroToClear, or clear).
+        raise GeneratorError("unsupported modifiedWriteValues (" + modified
+                             + "): " + name)
+    return "read_write"
+
+
+def field_bits(node):
+    """Offset and width of a field."""
+    if child_text(node, "bitOffset") is not None:
+        offset = parse_int(child_text(node, "bitOffset"))
+        width = parse_int(child_text(node, "bitWidth", "1"))
+    elif child_text(node, "lsb") is not None:
+        offset = parse_int(child_text(node, "lsb"))
+        width = parse_int(child_text(node, "msb")) - offset + 1
+    else:
+        match = re.match(r"\[(\w+):(\w+)\]", child_text(node, "bitRange", ""))
+        if match is None:
+            raise GeneratorError("field without bit range: "
+                                 + child_text(node, "name", "?"))
+        offset = parse_int(match.group(2))
+        width = parse_int(match.group(1)) - offset + 1
+    return offset, width
+
+
+class Register:
+    """Register (or register array) description."""
+
+    def __init__(self, name, offset, props, desc, dim=1, stride=0):
+        self.name = name
+        self.offset = offset
+        self.props = props
+        self.desc = desc
+        self.dim = dim
+        self.stride = stride
+        self.fields = []
+
+    def is_array(self):
+        return self.dim > 1
+
+    def size_in_bytes(self):
+        return self.props.size // 8 + (self.dim - 1) * self.stride
+
+
+def dim_elements(node):
+    """Number of elements and stride of an element using dim."""
+    if child_text(node, "dim") is None:
+        return 1, 0
+    return (parse_int(child_text(node, "dim")),
+            parse_int(child_text(node, "dimIncrement", "0")))
+
+
+def parse_registers(parent, props, base_offset, prefix, stride=None):
+    """Registers of a registers or cluster element (clusters flattened)."""
+    registers = []
+    for node in parent:
+        if node.tag not in ("register", "cluster"):
+            continue
+        name = prefix + child_text(node, "name")
+        offset = base_offset + parse_int(child_text(node, "addressOffset"))
+        node_props = props.derive(node)
+        dim, increment = dim_elements(node)
+        if node.tag == "cluster":
+            if dim > 1 and stride is None and increment > 0:
+                # Strided cluster: one register array per register.
+                registers += parse_registers(node, node_props, offset,
+                                             identifier(name) + "_",
+                                             (dim, increment))
+            else:
+                # Cluster elements are flattened.
+                for n in range(dim):
+                    element = re.sub(r"\[%s\]|%s", str(n) if dim > 1 else "",
+                                     name)
+                    registers += parse_registers(node, node_props,
+                                                 offset + n * increment,
+                                                 identifier(element) + "_",
+                                                 stride)
+            continue
+        if stride is None:
+            registers += make_registers(node, name, offset, node_props, dim,
+                                        increment)
+            continue
+        # Register in a strided cluster (one array per register element).
+        for n in range(dim):
+            element = re.sub(r"\[%s\]|%s", str(n) if dim > 1 else "", name)
+            registers += make_registers(node, element,
+                                        offset + n * increment, node_props,
+                                        stride[0], stride[1])
+    return registers
+
+
+def make_registers(node, name, offset, props, dim, increment):
+    """Register (array) for a register element."""
+    if props.size not in REG_SIZES:
+        raise GeneratorError("unsupported register size: " + name)
+    desc = description(node)
+
+    # Arrays are only used for valid strides (otherwise elements are
+    # defined as separate registers).
+    byte_size = props.size // 8
+    if dim > 1 and (increment < byte_size or increment % byte_size != 0):
+        result = []
+        for n in range(dim):
+            element = re.sub(r"\[%s\]|%s", str(n), name)
+            result += make_registers(node, element, offset + n * increment,
+                                     props, 1, 0)
+        return result
+
+    reg = Register(name, offset, props, desc, dim, increment)
+    fields_node = node.find("fields")
+    if fields_node is not None:
+        for field in fields_node.findall("field"):
+            field_props = props.derive(field)
+            bit_offset, width = field_bits(field)
+
+            # Field arrays are expanded into one field per element.
+            field_name = child_text(field, "name")
+            field_dim, field_increment = dim_elements(field)
+            if field_dim > 1 and field_increment < width:
+                raise GeneratorError("overlapping field array elements: "
+                                     + name + "." + field_name)
+            for n in range(field_dim):
+                element = re.sub(r"\[%s\]|%s",
+                                 str(n) if field_dim > 1 else "", field_name)
+                reg.fields.append((element,
+                                   bit_offset + n * field_increment,
+                                   width,
+                                   access_policy(field_props.access,
+                                                 field_props.modified,
+                                                 field_props.read_action,
+                                                 name + "." + element),
+                                   description(field)))
+    if not reg.fields:
+        # Registers without fields get a field covering the whole register.
+        reg.fields.append(("VALUE", 0, props.size,
+                           access_policy(props.access, props.modified,
+                                         props.read_action, name),
+                           ""))
+    return [reg]
+
+
+def reset_value(reg):
+    """Register reset value (masked with the reset mask)."""
+    value = reg.props.reset
+    if reg.props.reset_mask is not None:
+        value &= reg.props.reset_mask
+    return value & ((1 << reg.props.size) - 1)
+
+
+def render_layout(registers, pack_size, indent):
+    """Register definitions of a peripheral layout."""
+    lines = []
+    names = set()
+    for reg in registers:
+        name = identifier(reg.name, names)
+        names.add(name)
+        size = "RegBitSize::" + REG_SIZES[reg.props.size]
+        reset = "0x{:X}".format(reset_value(reg))
+        lines.append("")
+        lines += comment(reg.desc or name, indent)
+        if reg.is_array():
+            lines.append("{}struct {} : RegisterArray<Pack, {}, {}, {}, {}, "
+                         "{}> {{".format(indent, name, size, reg.offset * 8,
+                                         reg.stride * 8, reg.dim, reset))
+            field_type = "ArrayField"
+        else:
+            lines.append("{}struct {} : PackedRegister<Pack, {}, {}, {}> {{"
+                         .format(indent, name, size, reg.offset * 8, reset))
+            field_type = "Field"
+        field_names = set([name])
+        tables = []
+        for fname, offset, width, policy, fdesc in reg.fields:
+            member = identifier(fname, field_names)
+            field_names.add(member)
+            lines += comment(fdesc, indent + "    ")
+            lines.append("{}    using {} = {}<{}, {}u, {}u, {}>;"
+                         .format(indent, member, field_type, name, width,
+                                 offset, policy))
+            if reg.is_array():
+                tables.append(member)
+        lines.append(indent + "};")
+        for member in tables:
+            table = identifier(name + "_" + member + "_table", names)
+            names.add(table)
+            elements = ",\n{}                 ".format(indent).join(
+                "typename {}::{}::template at<{}>".format(name, member, n)
+                for n in range(reg.dim))
+            lines.append("{}using {} =".format(indent, table))
+            lines.append("{}    PackIndexing<{}>;".format(indent, elements))
+    return ["{}struct Pack : RegisterPack<base, 0x{:X}> {{}};"
+            .format(indent, pack_size)] + lines
+
+
+def pack_size(node, registers):
+    """Pack size in bytes (address blocks and registers extent)."""
+    size = 0
+    for block in node.findall("addressBlock"):
+        size = max(size, parse_int(child_text(block, "offset", "0"))
+                   + parse_int(child_text(block, "size", "0")))
+    for reg in registers:
+        size = max(size, reg.offset + reg.size_in_bytes())
+    return size
+
+
+def generate(svd_path, namespace):
+    """Header content for a SVD file."""
+    device = ET.parse(svd_path).getroot()
+    device_name = child_text(device, "name", "device")
+    device_props = Properties().derive(device)
+
+    # Peripherals (derived peripherals without registers use the registers
+    # of the peripheral they are derived from).
+    nodes = {}
+    for node in device.iter("peripheral"):
+        nodes[child_text(node, "name")] = node
+    peripherals = []
+    for name, node in nodes.items():
+        source = node
+        while (source.find("registers") is None
+               and source.get("derivedFrom") in nodes):
+            source = nodes[source.get("derivedFrom")]
+        props = device_props.derive(source).derive(node)
+        registers_node = source.find("registers")
+        registers = ([] if registers_node is None
+                     else parse_registers(registers_node, props, 0, ""))
+        if not registers:
+            continue
+        peripherals.append((identifier(name),
+                            parse_int(child_text(node, "baseAddress")),
+                            description(node) or description(source),
+                            "\n".join(render_layout(
+                                registers,
+                                pack_size(source, registers),
+                                "    "))))
+
+    # Layouts shared by the peripherals.
+    layouts = {}
+    for name, _, _, body in peripherals:
+        layouts.setdefault(body, identifier(name + "_layout"))
+
+    guard = "CPPREG_SVD_" + identifier(device_name).upper() + "_H"
+    out = [
+        "//! {} register definitions.".format(device_name),
+        "/**",
+        " * This file is generated from {} by svd2cppreg.py (do not edit)."
+        .format(svd_path.replace("\\", "/").split("/")[-1]),
+        " */",
+        "",
+        "",
+        "#ifndef " + guard,
+        "#define " + guard,
+        "",
+        "",
+        '#include "cppreg.h"',
+        "",
+        "",
+        "namespace {} {{".format(namespace),
+        "",
+        "",
+        "using namespace cppreg;",
+    ]
+    for body, layout in layouts.items():
+        out += ["",
+                "",
+                "//! {} register layout.".format(layout[:-len("_layout")]),
+                "template <Address base>",
+                "struct {} {{".format(layout),
+                body,
+                "};"]
+    out += ["", ""]
+    for name, address, desc, body in peripherals:
+        out += comment(desc or name, "")
+        out.append("using {} = {}<0x{:08X}>;"
+                   .format(name, layouts[body], address))
+    out += ["",
+            "",
+            "}}    // namespace {}".format(namespace),
+            "",
+            "",
+            "#endif    // " + guard,
+            ""]
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Generate cppreg register definitions from a SVD file.")
+    parser.add_argument("svd", help="CMSIS-SVD file")
+    parser.add_argument("output", help="generated header")
+    parser.add_argument("--namespace", help="namespace (default: device name)")
+    args = parser.parse_args()
+    try:
+        device = ET.parse(args.svd).getroot()
+        namespace = args.namespace or identifier(
+            child_text(device, "name", "device")).lower()
+        content = generate(args.svd, namespace)
+    except (ET.ParseError, GeneratorError, OSError, ValueError) as error:
+        sys.stderr.write("svd2cppreg: {}: {}\n".format(args.svd, error))
+        return 1
+    with open(args.output, "w") as output:
+        output.write(content)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())